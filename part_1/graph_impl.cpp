@@ -1,53 +1,635 @@
 #include "graph_impl.hpp"
+#include <thread>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-void Graph::addEdge(int u, int v, int cap) 
+Graph::Graph(const Graph& other) : V(other.V), E(other.E), directed(other.directed), dirty(false)
 {
-    if (u < 0 || u >= V || v < 0 || v >= V) 
+    other.ensure_csr(); // copy a compacted CSR, never a half-built one
+    offsets = other.offsets;
+    targets = other.targets;
+    weights = other.weights;
+    // A file-backed graph is shared, not copied: both graphs point into the same pages
+    mapping = other.mapping;
+    map_off = other.map_off;
+    map_tgt = other.map_tgt;
+    map_w = other.map_w;
+    map_arcs = other.map_arcs;
+}
+
+Graph::Graph(Graph&& other) noexcept
+    : V(other.V), E(other.E), directed(other.directed),
+      offsets(std::move(other.offsets)), targets(std::move(other.targets)), weights(std::move(other.weights)),
+      pending_src(std::move(other.pending_src)), pending_dst(std::move(other.pending_dst)),
+      pending_cap(std::move(other.pending_cap)), dirty(other.dirty.load()),
+      mapping(std::move(other.mapping)), map_off(other.map_off), map_tgt(other.map_tgt),
+      map_w(other.map_w), map_arcs(other.map_arcs)
+{
+}
+
+Graph& Graph::operator=(const Graph& other)
+{
+    if (this != &other)
+    {
+        Graph tmp(other);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+Graph& Graph::operator=(Graph&& other) noexcept
+{
+    if (this != &other)
+    {
+        V = other.V;
+        E = other.E;
+        directed = other.directed;
+        offsets = std::move(other.offsets);
+        targets = std::move(other.targets);
+        weights = std::move(other.weights);
+        pending_src = std::move(other.pending_src);
+        pending_dst = std::move(other.pending_dst);
+        pending_cap = std::move(other.pending_cap);
+        dirty = other.dirty.load();
+        mapping = std::move(other.mapping);
+        map_off = other.map_off;
+        map_tgt = other.map_tgt;
+        map_w = other.map_w;
+        map_arcs = other.map_arcs;
+    }
+    return *this;
+}
+
+const int* Graph::off_data() const
+{
+    return mapping ? map_off : offsets.data();
+}
+
+const int* Graph::tgt_data() const
+{
+    return mapping ? map_tgt : targets.data();
+}
+
+const int* Graph::w_data() const
+{
+    return mapping ? map_w : weights.data();
+}
+
+// Copy-on-write: a file-backed graph copies its arrays into owned vectors before the first mutation
+void Graph::materialize()
+{
+    if (!mapping)
+    {
+        return;
+    }
+    offsets.assign(map_off, map_off + V + 1);
+    targets.assign(map_tgt, map_tgt + map_arcs);
+    weights.assign(map_w, map_w + map_arcs);
+    mapping.reset();
+    map_off = map_tgt = map_w = nullptr;
+    map_arcs = 0;
+}
+
+void Graph::push_arc(int u, int v, int cap)
+{
+    pending_src.push_back(u);
+    pending_dst.push_back(v);
+    pending_cap.push_back(cap);
+}
+
+void Graph::addEdge(int u, int v, int cap)
+{
+    if (u < 0 || u >= V || v < 0 || v >= V)
     {
         throw std::out_of_range("Vertex index out of range");
     }
-    if (cap < 0) 
+    if (cap < 0)
     {
         throw std::invalid_argument("capacity must be non-negative");
     }
 
-    adj[u].push_back(v);
-    capacity[u][v] = cap;
-    if (!directed) 
+    materialize();
+    push_arc(u, v, cap);
+    if (!directed)
     {
-        adj[v].push_back(u);
-        capacity[v][u] = cap;
+        push_arc(v, u, cap);
     }
     ++E;
+    dirty = true;
+}
+
+/*
+Sorts one CSR row by (target, weight), permuting the weights along with the targets.
+Rows are kept sorted so that is_edge()/get_capacity() can binary search them;
+the weight tie-break keeps parallel arcs in a deterministic order.
+*/
+static void sort_row(int* tgt, int* w, int n)
+{
+    if (n < 2 || std::is_sorted(tgt, tgt + n))
+    {
+        return;
+    }
+    std::vector<std::pair<int, int>> row(n);
+    for (int i = 0; i < n; ++i)
+    {
+        row[i] = {tgt[i], w[i]};
+    }
+    std::sort(row.begin(), row.end());
+    for (int i = 0; i < n; ++i)
+    {
+        tgt[i] = row[i].first;
+        w[i] = row[i].second;
+    }
+}
+
+/*
+Compaction of the pending arcs into the CSR arrays (a counting sort by source vertex):
+1. Count the out-degree of every vertex (old CSR rows + pending arcs).
+2. Prefix-sum the degrees into the new offsets array.
+3. Scatter the old rows first and then the pending arcs.
+4. Re-sort only the rows that received new arcs, so every row stays sorted by target
+(this sorted order is the edge-membership index used by is_edge).
+Cost is O(V + arcs) plus the row sorts, paid once per batch of addEdge calls.
+*/
+void Graph::ensure_csr() const
+{
+    if (!dirty.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lk(csr_mu);
+    if (!dirty.load(std::memory_order_relaxed))
+    {
+        return; // another reader compacted while we waited
+    }
+
+    std::vector<int> newOffsets(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+    {
+        newOffsets[u + 1] = offsets[u + 1] - offsets[u];
+    }
+    for (int u : pending_src)
+    {
+        ++newOffsets[u + 1];
+    }
+    for (int u = 0; u < V; ++u)
+    {
+        newOffsets[u + 1] += newOffsets[u];
+    }
+
+    const int arcs = newOffsets[V];
+    std::vector<int> newTargets(arcs);
+    std::vector<int> newWeights(arcs);
+    std::vector<int> cursor(newOffsets.begin(), newOffsets.end() - 1);
+    for (int u = 0; u < V; ++u)
+    {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            newTargets[cursor[u]] = targets[i];
+            newWeights[cursor[u]] = weights[i];
+            ++cursor[u];
+        }
+    }
+    std::vector<char> touched(V, 0);
+    for (size_t i = 0; i < pending_src.size(); ++i)
+    {
+        int u = pending_src[i];
+        newTargets[cursor[u]] = pending_dst[i];
+        newWeights[cursor[u]] = pending_cap[i];
+        ++cursor[u];
+        touched[u] = 1;
+    }
+    for (int u = 0; u < V; ++u)
+    {
+        if (touched[u])
+        {
+            sort_row(newTargets.data() + newOffsets[u], newWeights.data() + newOffsets[u], newOffsets[u + 1] - newOffsets[u]);
+        }
+    }
+
+    offsets.swap(newOffsets);
+    targets.swap(newTargets);
+    weights.swap(newWeights);
+    std::vector<int>().swap(pending_src);
+    std::vector<int>().swap(pending_dst);
+    std::vector<int>().swap(pending_cap);
+    dirty.store(false, std::memory_order_release);
+}
+
+/*
+Runs body(begin, end) over [0, n) split into contiguous chunks, one per thread.
+Falls back to a plain call on the current thread when one thread is enough.
+*/
+template <typename Body>
+static void parallel_chunks(int n, int threads, Body body)
+{
+    if (threads <= 1 || n < 2)
+    {
+        body(0, n);
+        return;
+    }
+    std::vector<std::thread> pool;
+    int chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t)
+    {
+        int b = t * chunk;
+        int e = std::min(n, b + chunk);
+        if (b >= e)
+        {
+            break;
+        }
+        pool.emplace_back(body, b, e);
+    }
+    for (auto& th : pool)
+    {
+        th.join();
+    }
+}
+
+/*
+Parallel CSR construction from an edge array:
+1. Validate every edge (same rules as addEdge).
+2. Count out-degrees with atomic increments (each undirected edge counts at both ends).
+3. Prefix-sum the degrees into offsets.
+4. Scatter arcs into targets/weights, each thread claiming slots with an atomic cursor per row.
+5. Sort the rows in parallel so the result is identical to the addEdge path regardless of thread count.
+*/
+Graph Graph::from_edge_list(int vertices, bool isDirected, const std::vector<GraphEdge>& edges, int threads)
+{
+    Graph g(vertices, isDirected);
+    const int m = static_cast<int>(edges.size());
+
+    for (const auto& e : edges)
+    {
+        if (e.u < 0 || e.u >= vertices || e.v < 0 || e.v >= vertices)
+        {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        if (e.w < 0)
+        {
+            throw std::invalid_argument("capacity must be non-negative");
+        }
+    }
+
+    if (threads <= 0)
+    {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    const int kMinPerThread = 1 << 16; // below this, thread start-up costs more than it saves
+    threads = std::max(1, std::min(threads, m / kMinPerThread));
+
+    // 2) degree count
+    std::vector<std::atomic<int>> deg(vertices);
+    for (auto& d : deg)
+    {
+        d.store(0, std::memory_order_relaxed);
+    }
+    parallel_chunks(m, threads, [&](int b, int e)
+    {
+        for (int i = b; i < e; ++i)
+        {
+            deg[edges[i].u].fetch_add(1, std::memory_order_relaxed);
+            if (!isDirected)
+            {
+                deg[edges[i].v].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // 3) prefix sum (deg is reused as the per-row scatter cursor)
+    g.offsets.assign(vertices + 1, 0);
+    for (int u = 0; u < vertices; ++u)
+    {
+        g.offsets[u + 1] = g.offsets[u] + deg[u].load(std::memory_order_relaxed);
+        deg[u].store(g.offsets[u], std::memory_order_relaxed);
+    }
+
+    // 4) scatter
+    const int arcs = g.offsets[vertices];
+    g.targets.assign(arcs, 0);
+    g.weights.assign(arcs, 0);
+    parallel_chunks(m, threads, [&](int b, int e)
+    {
+        for (int i = b; i < e; ++i)
+        {
+            const GraphEdge& ed = edges[i];
+            int a = deg[ed.u].fetch_add(1, std::memory_order_relaxed);
+            g.targets[a] = ed.v;
+            g.weights[a] = ed.w;
+            if (!isDirected)
+            {
+                int r = deg[ed.v].fetch_add(1, std::memory_order_relaxed);
+                g.targets[r] = ed.u;
+                g.weights[r] = ed.w;
+            }
+        }
+    });
+
+    // 5) sort rows (the join above publishes all scattered arcs to these threads)
+    parallel_chunks(vertices, threads, [&](int b, int e)
+    {
+        for (int u = b; u < e; ++u)
+        {
+            sort_row(g.targets.data() + g.offsets[u], g.weights.data() + g.offsets[u], g.offsets[u + 1] - g.offsets[u]);
+        }
+    });
+
+    g.E = m;
+    return g;
+}
+
+int Graph::get_arcs() const
+{
+    ensure_csr();
+    return mapping ? map_arcs : static_cast<int>(targets.size());
+}
+
+bool Graph::is_mapped() const
+{
+    return static_cast<bool>(mapping);
+}
+
+IntSpan Graph::get_offsets() const
+{
+    ensure_csr();
+    return {off_data(), off_data() + V + 1};
+}
+
+IntSpan Graph::get_targets() const
+{
+    int arcs = get_arcs();
+    return {tgt_data(), tgt_data() + arcs};
+}
+
+IntSpan Graph::get_weights() const
+{
+    int arcs = get_arcs();
+    return {w_data(), w_data() + arcs};
+}
+
+int Graph::arc_begin(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    ensure_csr();
+    return off_data()[u];
+}
+
+int Graph::degree(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    ensure_csr();
+    const int* off = off_data();
+    return off[u + 1] - off[u];
 }
 
 // Return adjacency list of a vertex
-const std::vector<int>& Graph::get_neighbors(int u) const 
+IntSpan Graph::get_neighbors(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    ensure_csr();
+    const int* off = off_data();
+    return {tgt_data() + off[u], tgt_data() + off[u + 1]};
+}
+
+IntSpan Graph::get_neighbor_weights(int u) const
 {
-    if (u < 0 || u >= V) 
+    if (u < 0 || u >= V)
     {
         throw std::out_of_range("Vertex index out of range");
     }
-    return adj[u];
+    ensure_csr();
+    const int* off = off_data();
+    return {w_data() + off[u], w_data() + off[u + 1]};
 }
 
-bool Graph::is_edge(int u, int v) const 
+int Graph::get_capacity(int u, int v) const
 {
-    // Using const auto& ensures that the returned reference is not copied into a new vector:
-    const auto& neighbors = get_neighbors(u);
-    return std::find(neighbors.begin(), neighbors.end(), v) != neighbors.end();
+    const IntSpan nbrs = get_neighbors(u);
+    const IntSpan caps = get_neighbor_weights(u);
+    // Rows are sorted by target, so parallel arcs u->v form one contiguous run:
+    auto range = std::equal_range(nbrs.begin(), nbrs.end(), v);
+    int total = 0;
+    for (const int* it = range.first; it != range.second; ++it)
+    {
+        total += caps[static_cast<int>(it - nbrs.begin())];
+    }
+    return total;
+}
+
+bool Graph::is_edge(int u, int v) const
+{
+    // IntSpan is a view into the CSR arrays, so nothing is copied here.
+    // Rows are sorted by target, so this is a binary search: O(log deg(u)).
+    const IntSpan neighbors = get_neighbors(u);
+    return std::binary_search(neighbors.begin(), neighbors.end(), v);
 }
 
 // Print graph (for debugging)
-void Graph::print() const 
+void Graph::print() const
 {
-    for (int u = 0; u < V; u++) 
+    for (int u = 0; u < V; u++)
     {
         std::cout << u << ": ";
-        for (int v : adj[u]) 
+        for (int v : get_neighbors(u))
         {
             std::cout << v << " ";
         }
         std::cout << "\n";
     }
-}
\ No newline at end of file
+}
+
+// Rounds a byte position up to the next multiple of the array alignment
+static int64_t align_up(int64_t pos)
+{
+    return (pos + GRAPH_FILE_ALIGN - 1) / GRAPH_FILE_ALIGN * GRAPH_FILE_ALIGN;
+}
+
+/*
+Writes the graph in the binary CSR format:
+header | padding | offsets[V+1] | padding | targets[arcs] | padding | weights[arcs]
+Every array starts on a GRAPH_FILE_ALIGN boundary, so a reader can mmap the file
+and point straight into it.
+*/
+void Graph::save_binary(const std::string& path) const
+{
+    const IntSpan off = get_offsets();
+    const IntSpan tgt = get_targets();
+    const IntSpan w = get_weights();
+
+    GraphFileHeader h{};
+    std::memcpy(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic));
+    h.version = GRAPH_FILE_VERSION;
+    h.flags = directed ? GRAPH_FILE_DIRECTED : 0u;
+    h.vertices = V;
+    h.edges = E;
+    h.arcs = tgt.size();
+    h.offsets_pos = align_up(sizeof(GraphFileHeader));
+    h.targets_pos = align_up(h.offsets_pos + (int64_t)off.size() * (int64_t)sizeof(int));
+    h.weights_pos = align_up(h.targets_pos + h.arcs * (int64_t)sizeof(int));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("cannot open graph file for writing: " + path);
+    }
+    // Writes one array at its aligned position, zero-filling the gap before it
+    auto write_at = [&out](int64_t pos, const void* data, int64_t bytes)
+    {
+        static const char zeros[GRAPH_FILE_ALIGN] = {0};
+        int64_t cur = static_cast<int64_t>(out.tellp());
+        out.write(zeros, pos - cur);
+        out.write(static_cast<const char*>(data), bytes);
+    };
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    write_at(h.offsets_pos, off.data(), (int64_t)off.size() * (int64_t)sizeof(int));
+    write_at(h.targets_pos, tgt.data(), h.arcs * (int64_t)sizeof(int));
+    write_at(h.weights_pos, w.data(), h.arcs * (int64_t)sizeof(int));
+    if (!out)
+    {
+        throw std::runtime_error("failed writing graph file: " + path);
+    }
+}
+
+/*
+Opens a binary CSR file with mmap (read-only, shared), so the page cache backs the arrays
+and several processes loading the same file share one physical copy:
+1. Map the whole file (a regular file only) and validate the header (magic, version, sizes, aligned in-bounds arrays,
+   arcs = E directed or 2E undirected).
+2. Check offsets are monotone from 0 to arcs, every row is in-range and sorted, and, when
+undirected, that the rows mirror each other (sequential passes; nothing is parsed or copied).
+3. Return a Graph whose CSR accessors point into the mapping; the mapping is released
+when the last Graph sharing it is destroyed.
+*/
+Graph Graph::load_binary(const std::string& path)
+{
+    // O_NONBLOCK: opening a FIFO must not wait for a writer (it is rejected just below)
+    int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("cannot open graph file: " + path);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+    {
+        ::close(fd);
+        throw std::runtime_error("not a regular file: " + path);
+    }
+    if (st.st_size < (off_t)sizeof(GraphFileHeader))
+    {
+        ::close(fd);
+        throw std::runtime_error("graph file too small: " + path);
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+    if (base == MAP_FAILED)
+    {
+        throw std::runtime_error("mmap failed for graph file: " + path);
+    }
+    std::shared_ptr<const char> mapping(static_cast<const char*>(base), [size](const char* p)
+    {
+        munmap(const_cast<char*>(p), size);
+    });
+
+    GraphFileHeader h;
+    std::memcpy(&h, mapping.get(), sizeof(h));
+    auto in_bounds = [size](int64_t pos, int64_t count)
+    {
+        return pos >= (int64_t)sizeof(GraphFileHeader) && pos % GRAPH_FILE_ALIGN == 0 &&
+               count >= 0 && pos + count * (int64_t)sizeof(int) <= (int64_t)size;
+    };
+    if (std::memcmp(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic)) != 0 || h.version != GRAPH_FILE_VERSION)
+    {
+        throw std::runtime_error("not a graph file (bad magic/version): " + path);
+    }
+    const bool directed = (h.flags & GRAPH_FILE_DIRECTED) != 0;
+    if (h.vertices <= 0 || h.vertices >= INT32_MAX || h.arcs < 0 || h.arcs > INT32_MAX || h.edges < 0 ||
+        h.arcs != (directed ? h.edges : 2 * h.edges) || // an undirected edge is stored as two arcs
+        !in_bounds(h.offsets_pos, h.vertices + 1) || !in_bounds(h.targets_pos, h.arcs) || !in_bounds(h.weights_pos, h.arcs))
+    {
+        throw std::runtime_error("corrupt graph file header: " + path);
+    }
+
+    const int n = static_cast<int>(h.vertices);
+    const int arcs = static_cast<int>(h.arcs);
+    const int* off = reinterpret_cast<const int*>(mapping.get() + h.offsets_pos);
+    const int* tgt = reinterpret_cast<const int*>(mapping.get() + h.targets_pos);
+    const int* w = reinterpret_cast<const int*>(mapping.get() + h.weights_pos);
+    if (off[0] != 0 || off[n] != arcs)
+    {
+        throw std::runtime_error("corrupt graph file offsets: " + path);
+    }
+    for (int u = 0; u < n; ++u)
+    {
+        if (off[u + 1] < off[u])
+        {
+            throw std::runtime_error("corrupt graph file offsets: " + path);
+        }
+        for (int i = off[u]; i < off[u + 1]; ++i)
+        {
+            if (tgt[i] < 0 || tgt[i] >= n || w[i] < 0 || (i > off[u] && tgt[i] < tgt[i - 1]))
+            {
+                throw std::runtime_error("corrupt graph file arcs: " + path);
+            }
+        }
+    }
+    /*
+    Undirected rows must mirror each other: code that pairs the two arcs of an edge (the Euler
+    edge ids) walks the rows and lets u -> v (u < v) take the next unmatched v -> u, and a self-loop
+    take two adjacent u -> u. Pair them the same way here, so a file whose arcs do not pair up is
+    rejected instead of driving that pairing past the end of a row.
+    */
+    if (!directed)
+    {
+        std::vector<int> match(off, off + n); // next unmatched arc in each row
+        for (int u = 0; u < n; ++u)
+        {
+            for (int i = off[u]; i < off[u + 1]; ++i)
+            {
+                const int v = tgt[i];
+                bool paired;
+                if (v < u)
+                {
+                    paired = i < match[u]; // taken while row v was walked
+                }
+                else if (v == u)
+                {
+                    paired = i + 1 < off[u + 1] && tgt[i + 1] == u;
+                    ++i;
+                }
+                else
+                {
+                    paired = match[v] < off[v + 1] && tgt[match[v]] == u;
+                    ++match[v];
+                }
+                if (!paired)
+                {
+                    throw std::runtime_error("corrupt graph file: undirected arcs do not pair up: " + path);
+                }
+            }
+        }
+    }
+
+    Graph g(n, directed);
+    std::vector<int>().swap(g.offsets); // the mapping replaces the owned arrays
+    g.E = static_cast<int>(h.edges);
+    g.mapping = std::move(mapping);
+    g.map_off = off;
+    g.map_tgt = tgt;
+    g.map_w = w;
+    g.map_arcs = arcs;
+    return g;
+}
@@ -3,10 +3,18 @@
 @ author: Yarin Keshet
 @ date: 10-10-2025
 
-@ description: Graph implementation using adjacency list representation.
+@ description: Graph implementation using a compressed sparse row (CSR) representation.
 Supports both directed and undirected graphs with capacities on edges.
 Includes methods for adding edges, retrieving neighbors, checking edge existence, and printing the graph.
 Designed for use in network flow algorithms and other graph-related computations.
+
+Storage layout:
+* offsets[u] .. offsets[u+1] is the range of u's outgoing arcs inside targets/weights.
+* targets[i] is the head vertex of arc i, weights[i] is its capacity.
+* An undirected edge {u,v} is stored as two arcs (u->v and v->u), so memory grows with E, not V^2.
+* addEdge() appends to a small pending list; the CSR arrays are (re)built on the first read after it.
+* Every row is kept sorted by target vertex. That sorted order doubles as the edge-membership index:
+  is_edge(u,v) and get_capacity(u,v) are binary searches, O(log deg(u)) instead of O(deg(u)).
 */
 
 
@@ -16,52 +24,180 @@ Designed for use in network flow algorithms and other graph-related computations
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+// Read-only view over a contiguous run of ints (one CSR row, or a whole CSR array).
+struct IntSpan
+{
+    const int* first = nullptr;
+    const int* last = nullptr;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    const int* data() const { return first; }
+    int size() const { return static_cast<int>(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](int i) const { return first[i]; }
+};
+
+/*
+Binary graph file format (native byte order, little-endian on every platform we build for):
+* A 64-byte GraphFileHeader at position 0.
+* int32 offsets[V+1], int32 targets[arcs] and int32 weights[arcs], each starting at the
+  byte position recorded in the header, aligned to GRAPH_FILE_ALIGN.
+The arrays are exactly the in-memory CSR, so load_binary() can mmap the file and use it
+in place without parsing or copying.
+*/
+#define GRAPH_FILE_MAGIC "OSGRAPH"   // 7 chars + '\0' fill the 8-byte magic field
+#define GRAPH_FILE_VERSION 1u
+#define GRAPH_FILE_DIRECTED 1u       // flags bit 0
+#define GRAPH_FILE_ALIGN 64          // array alignment in bytes (one cache line)
+
+struct GraphFileHeader
+{
+    char magic[8];        // GRAPH_FILE_MAGIC
+    uint32_t version;     // GRAPH_FILE_VERSION
+    uint32_t flags;       // GRAPH_FILE_DIRECTED if the graph is directed
+    int64_t vertices;     // V
+    int64_t edges;        // E (logical edges, as counted by addEdge)
+    int64_t arcs;         // stored arcs (2*E when undirected)
+    int64_t offsets_pos;  // byte position of offsets[V+1]
+    int64_t targets_pos;  // byte position of targets[arcs]
+    int64_t weights_pos;  // byte position of weights[arcs]
+};
+static_assert(sizeof(GraphFileHeader) == 64, "graph file header must stay 64 bytes");
 
+// One input edge for bulk construction (u -> v with capacity w)
+struct GraphEdge
+{
+    int u, v, w;
+};
 
-class Graph 
+class Graph
 {
 private:
     int V;  // number of vertices
     int E;  // number of edges
     bool directed; // default is undirected
-    std::vector<std::vector<int>> adj; // adjacency list
-    std::vector<std::vector<int>> capacity; // capacity[u][v] = capacity of edge u->v
+
+    // CSR arrays (mutable because they are compacted lazily from const readers):
+    mutable std::vector<int> offsets; // size V+1, offsets[u] = first arc of u
+    mutable std::vector<int> targets; // head vertex of every arc
+    mutable std::vector<int> weights; // capacity of every arc
+
+    // Arcs added since the last compaction, kept as (src, dst, cap) triples:
+    mutable std::vector<int> pending_src;
+    mutable std::vector<int> pending_dst;
+    mutable std::vector<int> pending_cap;
+
+    mutable std::atomic<bool> dirty; // true while pending arcs are not yet merged into the CSR
+    mutable std::mutex csr_mu;       // serializes the lazy compaction
+
+    // File-backed CSR (set by load_binary): the arrays live in a shared read-only mmap
+    std::shared_ptr<const char> mapping; // unmaps when the last Graph using it goes away
+    const int* map_off = nullptr;
+    const int* map_tgt = nullptr;
+    const int* map_w = nullptr;
+    int map_arcs = 0;
+
+    // Current CSR arrays, owned or mapped
+    const int* off_data() const;
+    const int* tgt_data() const;
+    const int* w_data() const;
+
+    // Copies a mapped CSR into owned vectors (before the first mutation)
+    void materialize();
+
+    // Appends a single arc u->v to the pending list
+    void push_arc(int u, int v, int cap);
+
+    // Merges the pending arcs into the CSR arrays (no-op if there are none)
+    void ensure_csr() const;
 
 public:
 // Constructor:
 /*
-The vertices number passed to adj creates a vector with empty vector lists,
-the size of the vertices we have(each vertex represent an empty list of its neighbors)
+The vertices number passed creates an offsets array of V+1 zeros,
+meaning every vertex starts with an empty range of neighbors.
+No V x V matrix is allocated; capacities live next to each arc.
 */
-Graph(int vertices, bool isDirected) : 
-    V(vertices), E(0), directed(isDirected), adj(vertices), capacity(vertices, std::vector<int>(vertices, 0)) 
+Graph(int vertices, bool isDirected) :
+    V(vertices), E(0), directed(isDirected), offsets(vertices > 0 ? vertices + 1 : 1, 0), dirty(false)
     {
-        if (vertices <= 0) 
+        if (vertices <= 0)
         {
             throw std::invalid_argument("number of vertices must be positive");
         }
     }
 
+    // Copy / move (the mutex and the dirty flag are per-instance, so they are not copied)
+    Graph(const Graph& other);
+    Graph(Graph&& other) noexcept;
+    Graph& operator=(const Graph& other);
+    Graph& operator=(Graph&& other) noexcept;
+
     // Add edge (u -> v)
     void addEdge(int u, int v, int cap = 1); // default capacity is 1 if not specified
 
+    /*
+    Bulk builder: creates a graph from a whole edge array in one pass instead of E addEdge calls.
+    Degrees are counted, prefix-summed and the arcs scattered straight into the CSR arrays,
+    using up to 'threads' worker threads (0 = hardware concurrency; small inputs stay single-threaded).
+    Throws the same exceptions as addEdge for out-of-range vertices or negative capacities.
+    */
+    static Graph from_edge_list(int vertices, bool isDirected, const std::vector<GraphEdge>& edges, int threads = 0);
+
+    // Writes the graph in the binary CSR file format (throws std::runtime_error on I/O errors)
+    void save_binary(const std::string& path) const;
+
+    /*
+    Opens a binary CSR file zero-copy via mmap. The returned graph reads straight from the
+    page cache; addEdge() on it first copies the arrays into memory (copy-on-write).
+    Throws std::runtime_error if the file is missing or malformed.
+    */
+    static Graph load_binary(const std::string& path);
+
+    // True if the CSR arrays are served from a mapped file
+    bool is_mapped() const;
+
 
     // Get number of vertices
     int get_vertices() const { return V; }
 
-    // Return the full adjacency list
-    const std::vector<std::vector<int>>& getAdjList() const { return adj; }
-    
     // Get number of edges
     int get_edges() const { return E; }
 
-    // Return adjacency list of a vertex
-    const std::vector<int>& get_neighbors(int u) const;
+    // True if the graph was created as directed
+    bool is_directed() const { return directed; }
 
-    // Getter for capacity
-    const std::vector<std::vector<int>>& get_capacity() const { return capacity; }
+    // Number of stored arcs (2*E for undirected graphs, E for directed ones)
+    int get_arcs() const;
 
-    // Returns true if there is an edge from u to v
+    // Raw CSR arrays (offsets has V+1 entries, targets/weights have get_arcs() entries)
+    IntSpan get_offsets() const;
+    IntSpan get_targets() const;
+    IntSpan get_weights() const;
+
+    // Index of the first arc of u inside get_targets()/get_weights()
+    int arc_begin(int u) const;
+
+    // Out-degree of u (number of stored arcs leaving u)
+    int degree(int u) const;
+
+    // Return adjacency list of a vertex (sorted by neighbor id)
+    IntSpan get_neighbors(int u) const;
+
+    // Capacities of u's arcs, aligned with get_neighbors(u)
+    IntSpan get_neighbor_weights(int u) const;
+
+    // Capacity of u->v (sum over parallel arcs), 0 if there is no such edge
+    int get_capacity(int u, int v) const;
+
+    // Returns true if there is an edge from u to v (binary search in u's sorted row)
     bool is_edge(int u, int v) const;
 
     // Print graph (for debugging)
@@ -69,5 +205,3 @@ Graph(int vertices, bool isDirected) :
 
 
 };
-
-
@@ -36,8 +36,9 @@ int main()
     // Test getters
     std::cout << "Vertices: " << g.get_vertices() << std::endl;
     std::cout << "Edges: " << g.get_edges() << std::endl;
-    (void)g.getAdjList();
-    (void)g.get_capacity();
+    (void)g.get_offsets();
+    std::cout << "Arcs: " << g.get_arcs() << std::endl;
+    std::cout << "capacity(0,1): " << g.get_capacity(0, 1) << std::endl;
 
     // Test is_edge function
     std::cout << "is_edge(0,1): " << g.is_edge(0,1) << std::endl;
@@ -63,8 +64,10 @@ int main()
     // Test getters for directed graph
     std::cout << "Directed Vertices: " << d.get_vertices() << std::endl;
     std::cout << "Directed Edges: " << d.get_edges() << std::endl;
-    (void)d.getAdjList();
-    (void)d.get_capacity();
+    (void)d.get_targets();
+    (void)d.get_weights();
+    std::cout << "capacity(0,1): " << d.get_capacity(0, 1) << std::endl;
+    std::cout << "capacity(1,0): " << d.get_capacity(1, 0) << std::endl;
 
     // Test is_edge for directed graph
     std::cout << "is_edge(1,2): " << d.is_edge(1,2) << std::endl;
@@ -74,5 +77,41 @@ int main()
     std::cout << "Directed graph adjacency list:\n";
     d.print();
 
+    // ===== Bulk construction from an edge list =====
+    std::vector<GraphEdge> edges = {{0, 1, 2}, {1, 2, 3}, {2, 0, 4}, {0, 2, 1}};
+    Graph b = Graph::from_edge_list(3, false, edges);
+    std::cout << "Bulk Edges: " << b.get_edges() << std::endl;
+    std::cout << "Bulk capacity(0,2): " << b.get_capacity(0, 2) << std::endl;
+    std::cout << "Bulk graph adjacency list:\n";
+    b.print();
+
+    // Invalid bulk edge (should throw out_of_range)
+    try
+    {
+        Graph bad = Graph::from_edge_list(3, true, {{0, 3, 1}});
+    }
+    catch (const std::out_of_range& e)
+    {
+        std::cout << "Caught exception: " << e.what() << std::endl;
+    }
+
+    // ===== Binary file round trip (mmap, zero-copy) =====
+    b.save_binary("graph_case2.bin");
+    Graph m = Graph::load_binary("graph_case2.bin");
+    std::cout << "Mapped: " << m.is_mapped() << " Edges: " << m.get_edges() << std::endl;
+    std::cout << "Mapped capacity(0,2): " << m.get_capacity(0, 2) << std::endl;
+    m.addEdge(1, 1, 9); // copy-on-write: the graph leaves the mapping
+    std::cout << "Mapped after addEdge: " << m.is_mapped() << std::endl;
+
+    // Missing file (should throw runtime_error)
+    try
+    {
+        Graph missing = Graph::load_binary("no_such_graph.bin");
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "Caught runtime_error: " << e.what() << std::endl;
+    }
+
     return 0;
 }
@@ -1,35 +1,200 @@
 #include "euler_circle.hpp"
 
-void EulerCircle::findEulerianCircuit() 
+// Union-find root with path halving (used by the connectivity check)
+static int findRoot(std::vector<int>& parent, int x)
 {
-    std::vector<std::vector<int>> adjList = g.getAdjList(); // copy the adjacency list
-    int V = adjList.size();
-    bool isEulerian = true;
-    // Check for undirected graph: all degrees must be even
-    for (int u = 0; u < V; ++u) 
+    while (parent[x] != x)
     {
-        if (adjList[u].size() % 2 != 0) 
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+int EulerCircle::eulerEndpoint(bool allowPath, bool& isCircuit, std::ostream& diag) const
+{
+    const int V = g.get_vertices();
+    const IntSpan off = g.get_offsets();
+    const IntSpan tgt = g.get_targets();
+    const char* kind = allowPath ? "path" : "circuit";
+    isCircuit = false;
+
+    // In-degrees (only differ from out-degrees in a directed graph)
+    std::vector<int> inDeg;
+    if (g.is_directed())
+    {
+        inDeg.assign(V, 0);
+        for (int v : tgt)
+        {
+            ++inDeg[v];
+        }
+    }
+
+    // Vertices that break the circuit condition: odd degree, or in-degree != out-degree
+    std::vector<int> unbalanced;
+    int end = -1;        // where an Euler path has to finish
+    bool pathOk = true;  // the unbalanced vertices still allow an Euler path
+    for (int u = 0; u < V; ++u)
+    {
+        int out = off[u + 1] - off[u];
+        if (!g.is_directed())
+        {
+            if (out % 2 != 0)
+            {
+                unbalanced.push_back(u);
+                end = u; // an undirected path may finish at either odd vertex
+            }
+        }
+        else if (out != inDeg[u])
+        {
+            unbalanced.push_back(u);
+            if (out - inDeg[u] == -1 && end < 0)
+            {
+                end = u; // one more arc comes in than goes out: the path finishes here
+            }
+            else if (out - inDeg[u] != 1)
+            {
+                pathOk = false;
+            }
+        }
+    }
+    pathOk = pathOk && unbalanced.size() == 2 && end >= 0;
+
+    if (!unbalanced.empty() && !(allowPath && pathOk))
+    {
+        for (int u : unbalanced)
         {
-            isEulerian = false;
-            std::cout << "Vertex " << u << " has odd degree: " << adjList[u].size() << std::endl;
+            if (g.is_directed())
+            {
+                diag << "Vertex " << u << " has in-degree " << inDeg[u] << " and out-degree " << off[u + 1] - off[u] << std::endl;
+            }
+            else
+            {
+                diag << "Vertex " << u << " has odd degree: " << off[u + 1] - off[u] << std::endl;
+            }
+        }
+        if (!allowPath)
+        {
+            diag << (g.is_directed() ? "No Eulerian circuit exists: in-degree differs from out-degree."
+                                     : "No Eulerian circuit exists: not all vertices have even degree.") << std::endl;
+        }
+        else
+        {
+            diag << (g.is_directed() ? "No Eulerian path exists: more than one vertex has an extra outgoing or incoming arc."
+                                     : "No Eulerian path exists: more than two vertices have odd degree.") << std::endl;
+        }
+        return -1;
+    }
+
+    // All edges must lie in one (weakly) connected component
+    std::vector<int> parent(V);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (int u = 0; u < V; ++u)
+    {
+        for (int i = off[u]; i < off[u + 1]; ++i)
+        {
+            parent[findRoot(parent, u)] = findRoot(parent, tgt[i]);
+        }
+    }
+    int first = -1; // first vertex that has an edge
+    for (int u = 0; u < V; ++u)
+    {
+        bool hasEdge = off[u + 1] > off[u] || (g.is_directed() && inDeg[u] > 0);
+        if (!hasEdge)
+        {
+            continue;
+        }
+        if (first < 0)
+        {
+            first = u;
+        }
+        else if (findRoot(parent, u) != findRoot(parent, first))
+        {
+            diag << "No Eulerian " << kind << " exists: the edges are not all connected." << std::endl;
+            return -1;
         }
     }
-    if (!isEulerian) 
+
+    if (unbalanced.empty())
+    {
+        isCircuit = true;
+        return first < 0 ? 0 : first; // no edges at all: the circuit is the single vertex 0
+    }
+    return end;
+}
+
+// Prints "Eulerian circuit: ..." / "Eulerian path: ..." by streaming the walk into 'out'
+static bool printWalk(const EulerCircle& ec, bool allowPath, std::ostream& out)
+{
+    bool isCircuit = false;
+    int end = ec.eulerEndpoint(allowPath, isCircuit, out);
+    if (end < 0)
+    {
+        return false;
+    }
+    out << (isCircuit ? "Eulerian circuit: " : "Eulerian path: ");
+    ec.walk(end, [&out](int v) { out << v << " "; });
+    out << std::endl;
+    return true;
+}
+
+bool EulerCircle::findEulerianCircuit(std::ostream& out)
+{
+    return printWalk(*this, false, out);
+}
+
+bool EulerCircle::findEulerianPath(std::ostream& out)
+{
+    return printWalk(*this, true, out);
+}
+
+/*
+Edge ids for the CSR arcs.
+Directed: every arc is its own edge.
+Undirected: rows are sorted by target, so the arcs v->u with u < v sit at the front of v's row
+in increasing u. Walking u = 0..V-1 and handing out the next unmatched slot of row v for
+every arc u->v (u < v) therefore pairs each arc with its reverse in one linear pass,
+parallel edges included. A self-loop is stored as two adjacent arcs u->u, which are paired
+with each other.
+*/
+void EulerCircle::assignEdgeIds(std::vector<int>& edgeId) const
+{
+    const int V = g.get_vertices();
+    const IntSpan off = g.get_offsets();
+    const IntSpan tgt = g.get_targets();
+    edgeId.assign(g.get_arcs(), -1);
+
+    if (g.is_directed())
     {
-        std::cout << "No Eulerian circuit exists: not all vertices have even degree." << std::endl;
+        for (int i = 0; i < g.get_arcs(); ++i)
+        {
+            edgeId[i] = i;
+        }
         return;
     }
 
-    // If all degrees are even, run Hierholzer's algorithm
-    std::vector<int> circuit; // initialize
-    hierholzer(adjList, 0, circuit);
-    // Print the Eulerian circuit
-    std::cout << "Eulerian circuit: ";
-    for (int v : circuit) 
+    std::vector<int> match(off.begin(), off.end() - 1); // next unmatched reverse arc in each row
+    int next = 0;
+    for (int u = 0; u < V; ++u)
     {
-        std::cout << v << " ";
+        for (int i = off[u]; i < off[u + 1]; ++i)
+        {
+            int v = tgt[i];
+            if (v > u)
+            {
+                edgeId[i] = next;
+                edgeId[match[v]++] = next;
+                ++next;
+            }
+            else if (v == u && edgeId[i] < 0)
+            {
+                edgeId[i] = next;
+                edgeId[i + 1] = next;
+                ++next;
+            }
+            // v < u: already paired while row v was walked
+        }
     }
-    std::cout << std::endl;
 }
 
 /*
@@ -43,34 +208,86 @@ and merge the cycles.
 
 Result: a path that visits every edge exactly once and returns to the start.
 
+Edges are never erased from an adjacency list. Instead each vertex keeps a cursor into its CSR row
+and a bitmap marks the edge ids already walked; both directions of an undirected edge share one id,
+so taking u->v also retires v->u in O(1). Every arc is passed over once, which makes the whole
+run O(V+E) with no copy of the graph.
+
+A vertex is final once the algorithm backtracks out of it, so the backtracking order is the walk
+reversed, ending at the start vertex. That order is handed to the sink directly, which is what lets the
+walk be streamed without storing it:
+* Undirected: a reversed Euler walk is itself an Euler walk, so nothing else is needed.
+* Directed: the algorithm runs on the transposed graph; a walk of the transpose, reversed, is a walk of g.
 */
-void EulerCircle::hierholzer(std::vector<std::vector<int>>& adjList, int start, std::vector<int>& circuit) 
+long long EulerCircle::walk(int end, const EulerSink& sink) const
 {
+    const int V = g.get_vertices();
+    const int arcs = g.get_arcs();
+
+    std::vector<int> edgeId;
+    assignEdgeIds(edgeId);
+
+    const int* off = g.get_offsets().data();
+    const int* tgt = g.get_targets().data();
+    std::vector<int> tOff, tTgt; // transposed CSR (directed graphs only)
+    if (g.is_directed())
+    {
+        tOff.assign(V + 1, 0);
+        tTgt.resize(arcs);
+        for (int i = 0; i < arcs; ++i)
+        {
+            ++tOff[tgt[i] + 1];
+        }
+        for (int u = 0; u < V; ++u)
+        {
+            tOff[u + 1] += tOff[u];
+        }
+        std::vector<int> fill(tOff.begin(), tOff.end() - 1);
+        for (int u = 0; u < V; ++u)
+        {
+            for (int i = off[u]; i < off[u + 1]; ++i)
+            {
+                tTgt[fill[tgt[i]]++] = u;
+            }
+        }
+        off = tOff.data();
+        tgt = tTgt.data();
+    }
+
+    std::vector<bool> used(g.get_edges(), false); // used-edge bitmap, indexed by edge id
+
+    // cursor[u] walks u's row from the back (same visiting order as popping an adjacency list)
+    std::vector<int> cursor(off + 1, off + V + 1);
+
+    long long walked = -1; // vertices emitted minus one
     std::vector<int> stack;
-    stack.push_back(start);
+    stack.push_back(end);
     while (!stack.empty()) 
     {
         int u = stack.back();
-        if (!adjList[u].empty()) 
+        int& c = cursor[u];
+        while (c > off[u] && used[edgeId[c - 1]])
         {
-            int v = adjList[u].back(); // saves the v vertex
-            adjList[u].pop_back(); // removes the last neighbor (vertex) from the adjacency list of vertex u(the edge uv is removed)
-            // Remove the edge in the other direction for undirected graphs
-            for (auto it = adjList[v].begin(); it != adjList[v].end(); ++it) 
-            {
-                if (*it == u) 
-                {
-                    adjList[v].erase(it);
-                    break;
-                }
-            }
-            stack.push_back(v);
+            --c; // skip arcs whose edge was already taken from the other end
+        }
+        if (c > off[u]) 
+        {
+            --c;
+            used[edgeId[c]] = true; // the edge uv is removed (both directions)
+            stack.push_back(tgt[c]);
         }
         else 
         {
-            circuit.push_back(u);
+            sink(u);
+            ++walked;
             stack.pop_back();
         }
     }
-    std::reverse(circuit.begin(), circuit.end()); // reverse the circuit to get the correct order
+    return walked;
+}
+
+void EulerCircle::hierholzer(int start, std::vector<int>& circuit)
+{
+    circuit.reserve(circuit.size() + g.get_edges() + 1);
+    walk(start, [&circuit](int v) { circuit.push_back(v); });
 }
@@ -1,10 +1,14 @@
 /*
 @author: Roy Meoded
-@author: Yarin Keshet  
+@author: Yarin Keshet
 @ date: 10-10-2025
 
-@ description: This file contains the implementation of the EulerCircle class, 
+@ description: This file contains the implementation of the EulerCircle class,
 which provides functionality to find an Eulerian circuit in a given graph using Hierholzer's algorithm.
+Both undirected graphs (every degree even) and directed graphs (in-degree == out-degree) are supported,
+as well as Eulerian paths (exactly two odd / unbalanced vertices).
+The walk is produced one vertex at a time into a caller-supplied sink, so a large circuit can be
+streamed (for example straight to a socket) without first being collected as text.
 */
 
 #pragma once
@@ -13,17 +17,43 @@ which provides functionality to find an Eulerian circuit in a given graph using
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <functional>
 #include "../part_1/graph_impl.hpp"
 
-class EulerCircle 
+// Receives an Euler walk one vertex at a time, in walk order
+using EulerSink = std::function<void(int)>;
+
+class EulerCircle
 {
 public:
     EulerCircle(const Graph& graph) : g(graph) {}
 
-    void findEulerianCircuit(); 
+    // Prints an Eulerian circuit to 'out', or the reason there is none. Returns true if a circuit was printed.
+    bool findEulerianCircuit(std::ostream& out = std::cout);
+
+    // Prints an Eulerian circuit if there is one, otherwise an Eulerian path, otherwise the reason there is neither.
+    bool findEulerianPath(std::ostream& out = std::cout);
+
+    /*
+    Checks the Euler conditions on g: degree parity (undirected) or in/out balance (directed),
+    and that all edges lie in one connected component.
+    Returns the vertex the walk must finish at, or -1 if there is no Euler walk of the requested
+    kind (the reasons are written to 'diag'). 'isCircuit' tells whether the walk is closed.
+    */
+    int eulerEndpoint(bool allowPath, bool& isCircuit, std::ostream& diag) const;
+
+    // Streams an Euler walk that finishes at 'end' into 'sink'. Returns the number of edges walked.
+    long long walk(int end, const EulerSink& sink) const;
 
     const Graph& g;
 
-    // Hierholzer's algorithm for Eulerian circuit
-    void hierholzer(std::vector<std::vector<int>>& adjList, int start, std::vector<int>& circuit);
-};
\ No newline at end of file
+    /*
+    Gives every stored arc the id of the edge it belongs to. In an undirected graph
+    the two arcs u->v and v->u of one edge share an id, so using the edge once
+    retires both directions. Ids are dense in [0, E). O(V+E).
+    */
+    void assignEdgeIds(std::vector<int>& edgeId) const;
+
+    // Hierholzer's algorithm for Eulerian circuit (collects walk(start) into 'circuit')
+    void hierholzer(int start, std::vector<int>& circuit);
+};
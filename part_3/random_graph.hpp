@@ -5,6 +5,7 @@
 
 @description: Header file for random graph generation, declares function to generate a random undirected graph
 with specified number of vertices, edges, and a seed for randomness.
+The sampling is shared with the part_8 generator (part_8/include/random_graph.cpp).
 This file includes the Graph class from part_1/graph_impl.hpp to utilize its graph representation and methods.
 */
 
@@ -202,16 +202,17 @@ void run_client()
         // Sending Graph Data and Receiving Response
         send(sock, graph_data.c_str(), graph_data.size(), 0);
         /*
-        Reads up to 4096 bytes of data from the server through the socket sock.
-        The data is stored in the buffer array.
-        valread will contain the number of bytes actually read (could be less than 4096).
+        Reads the server's answer through the socket sock, up to 4096 bytes at a time.
+        The server streams long circuits in several pieces and closes the connection when it is done,
+        so we keep reading (and printing) until read() returns 0.
         */
-        int valread = read(sock, buffer, 4096);
-        /*
-        Converts the received bytes in buffer to a string (using only the bytes actually read).
-        Prints the server’s response to the user.
-        */
-        std::cout << "Server response:\n" << std::string(buffer, valread) << std::endl;
+        std::cout << "Server response:\n";
+        int valread;
+        while ((valread = read(sock, buffer, 4096)) > 0)
+        {
+            std::cout << std::string(buffer, valread);
+        }
+        std::cout << std::endl;
 
         close(sock); // Close the socket
 
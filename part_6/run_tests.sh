@@ -218,6 +218,18 @@ send_raw "5 6\n0 1\n1 2\n2 3\n3 4\n4 0\n1 3\n" build/raw_many_edges.out build/ra
 echo "[30] RAW: Parse failure (non-numeric start)"
 send_raw "abc xyz\n" build/raw_parse_fail.out build/raw_parse_fail.err
 
+echo "[30.1] RAW: Euler path (two odd vertices)"
+send_raw "4 3\n0 1\n1 2\n2 3\n" build/raw_euler_path.out build/raw_euler_path.err
+
+echo "[30.2] RAW: Directed Eulerian circuit"
+send_raw "DIRECTED 3 3\n0 1\n1 2\n2 0\n" build/raw_directed_circuit.out build/raw_directed_circuit.err
+
+echo "[30.3] RAW: Directed graph with unbalanced vertices"
+send_raw "DIRECTED 3 2\n0 1\n0 2\n" build/raw_directed_unbalanced.out build/raw_directed_unbalanced.err
+
+echo "[30.4] RAW: Disconnected edges (no Euler walk)"
+send_raw "6 6\n0 1\n1 2\n2 0\n3 4\n4 5\n5 3\n" build/raw_disconnected.out build/raw_disconnected.err
+
 # --------- Clean shutdown of the main server ---------
 echo "[31] EXIT_CLIENT to close main server (clean coverage flush)"
 timeout 6s ./client > /dev/null 2>&1 <<'EOF'
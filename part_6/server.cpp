@@ -1,5 +1,68 @@
 #include "server.hpp"
 #include <cstdlib> // getenv
+#include <algorithm> // std::min
+#include <cerrno>
+#include <cctype>
+#include <climits> // INT_MAX
+#include <sys/time.h> // timeval for SO_RCVTIMEO
+
+/*
+Output stream buffer that writes straight to a connected socket.
+The Euler walk is printed through it vertex by vertex, so a circuit with millions of
+vertices goes out in fixed-size chunks instead of being built up as one big string first.
+*/
+class SocketStreamBuf : public std::streambuf
+{
+public:
+    explicit SocketStreamBuf(int fd) : fd(fd), sent(0)
+    {
+        setp(buf, buf + sizeof(buf));
+    }
+    ~SocketStreamBuf() override { sync(); }
+
+    long long bytes_sent() const { return sent; }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (flush_buffer() < 0)
+        {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flush_buffer(); }
+
+private:
+    // Sends everything buffered so far (send() may take it in several pieces)
+    int flush_buffer()
+    {
+        const char* p = pbase();
+        while (p < pptr())
+        {
+            ssize_t n = send(fd, p, pptr() - p, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                setp(buf, buf + sizeof(buf)); // client went away: drop the rest
+                return -1;
+            }
+            p += n;
+            sent += n;
+        }
+        setp(buf, buf + sizeof(buf));
+        return 0;
+    }
+
+    int fd;
+    long long sent;
+    char buf[64 * 1024];
+};
 
 // Wrapper for exit that can be suppressed during cumulative coverage runs.
 static void coverage_exit(int code)
@@ -12,6 +75,84 @@ static void coverage_exit(int code)
     exit(code);
 }
 
+/*
+Reads one whole request from the client: until EOF, or until the header ("[DIRECTED] V E")
+and the E edge lines it announces have all arrived (the client sends without closing its
+side). A single read() only ever saw the first 4KB, so large graphs were cut off.
+A client that stops sending for REQUEST_IDLE_SEC ends the request with what arrived so far,
+which the parser then reports as an incomplete edge list.
+*/
+static std::string read_request(int fd)
+{
+    timeval tv{REQUEST_IDLE_SEC, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    std::string input;
+    std::vector<std::string> header; // first tokens: [DIRECTED] V E
+    long long tokens = 0;            // whitespace-separated tokens completed so far
+    long long needed = -1;           // tokens the whole request has, once the header is known
+    bool in_token = false;
+    char buf[64 * 1024];
+    while (true)
+    {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break; // EOF, error or idle timeout
+        }
+        size_t start = input.size();
+        input.append(buf, (size_t)n);
+        if (input == "EXIT_CLIENT")
+        {
+            break;
+        }
+        for (size_t i = start; i < input.size(); i++)
+        {
+            bool space = std::isspace((unsigned char)input[i]);
+            if (!space && !in_token)
+            {
+                in_token = true;
+                if (header.size() < 3)
+                {
+                    header.emplace_back();
+                }
+            }
+            else if (space && in_token)
+            {
+                in_token = false;
+                tokens++;
+            }
+            if (!space && tokens < 3 && header.size() == (size_t)tokens + 1)
+            {
+                header.back() += input[i];
+            }
+        }
+        if (needed < 0)
+        {
+            size_t h = (!header.empty() && header[0] == "DIRECTED") ? 1 : 0;
+            if (tokens >= (long long)h + 2)
+            {
+                char* end = nullptr;
+                long long V = std::strtoll(header[h].c_str(), &end, 10);
+                bool okV = *end == '\0';
+                long long E = std::strtoll(header[h + 1].c_str(), &end, 10);
+                bool okE = *end == '\0';
+                // A header the parser rejects needs no edge lines
+                needed = (okV && okE && V > 0 && E >= 0 && E <= INT_MAX) ? (long long)h + 2 + 2 * E : (long long)h + 2;
+            }
+        }
+        if (needed >= 0 && tokens >= needed)
+        {
+            break;
+        }
+    }
+    return input;
+}
+
 void run_server()
 {
     // Main variables for socket setup & client handling.
@@ -19,7 +160,6 @@ void run_server()
     struct sockaddr_in address;
     int opt = 1; // option for setsockopt
     int addrlen = sizeof(address);
-    char buffer[4096] = {0}; // buffer to store incoming data
 
     // Create socket file descriptor:
     int server_fd = socket(AF_INET, SOCK_STREAM, 0);
@@ -105,8 +245,7 @@ void run_server()
             break;
         }
 
-        int valread = read(new_socket, buffer, 4096);
-        std::string input(buffer, valread);
+        std::string input = read_request(new_socket);
 
         if (input == "EXIT_CLIENT")
         {
@@ -119,6 +258,18 @@ void run_server()
 
         std::istringstream iss(input);
         int V = 0, E = 0;
+        // Optional "DIRECTED" before V and E asks for a directed Euler circuit/path
+        bool directed = false;
+        std::string first;
+        if (iss >> first && first == "DIRECTED")
+        {
+            directed = true;
+        }
+        else
+        {
+            iss.clear();
+            iss.seekg(0);
+        }
         iss >> V >> E;
 
         std::ostringstream msg;
@@ -132,32 +283,45 @@ void run_server()
         }
         else
         {
-            Graph g(V, false); // false for undirected
+            std::vector<GraphEdge> edges; // validated edges, built into the graph in one pass
+            // E comes from the client: reserve only what the received bytes can hold ("u v\n" is at least 4 bytes)
+            edges.reserve(std::min<size_t>((size_t)E, input.size() / 4));
             bool valid = true;
             for (int i = 0; i < E; ++i)
             {
                 int u, v;
-                iss >> u >> v;
+                if (!(iss >> u >> v))
+                {
+                    msg << "Error: Expected " << E << " edges but only " << i << " were received.\n";
+                    valid = false;
+                    break;
+                }
                 if (u < 0 || v < 0 || u >= V || v >= V)
                 {
                     msg << "Error: Invalid edge (" << u << ", " << v << "). Vertices must be in range 0 to " << V - 1 << ".\n";
                     valid = false;
                     break;
                 }
-                g.addEdge(u, v);
+                edges.push_back({u, v, 1});
             }
             if (valid)
             {
-                std::ostringstream oss;
-                std::streambuf *old_cout = std::cout.rdbuf(oss.rdbuf());
+                Graph g = Graph::from_edge_list(V, directed, edges);
+
+                // Stream the answer straight to the socket (no copy of the circuit as text)
+                SocketStreamBuf sockbuf(new_socket);
+                std::ostream out(&sockbuf);
+                out << "Welcome to the Euler Graph Server!\n";
+                out << "Vertices: " << V << "\n";
+                out << "Edges: " << E << "\n";
                 EulerCircle ec(g);
-                ec.findEulerianCircuit();
-                std::cout.rdbuf(old_cout);
+                ec.findEulerianPath(out); // circuit if there is one, otherwise an Euler path
+                out.flush();
 
-                msg << "Welcome to the Euler Graph Server!\n";
-                msg << "Vertices: " << V << "\n";
-                msg << "Edges: " << E << "\n";
-                msg << oss.str();
+                std::cout << "Received from client:\n" << input << std::endl;
+                std::cout << "Response streamed: " << sockbuf.bytes_sent() << " bytes" << std::endl;
+                close(new_socket);
+                continue;
             }
         }
         std::string result = msg.str();
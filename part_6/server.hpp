@@ -23,5 +23,6 @@ After 30 seconds of no client connection, the server will shut down.
 #include "../part_2/euler_circle.hpp"
 
 #define PORT 8080 // Default port
+#define REQUEST_IDLE_SEC 2 // a client silent this long mid-request has sent all it will
 
 void run_server(); 
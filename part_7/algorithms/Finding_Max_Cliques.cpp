@@ -0,0 +1,198 @@
+#include "Finding_Max_Cliques.hpp"
+#include <stdexcept>
+#include <iterator>
+
+// A neighbour list this many times longer than the set is searched, not merged
+#define MAX_CLIQUES_GALLOP_RATIO 8
+
+int FindingMaxCliques::commonWith(const std::vector<int>& set, int u) const
+{
+    const int* row = nbr.data() + off[u];
+    const int* rowEnd = nbr.data() + off[u + 1];
+    int common = 0;
+    if ((rowEnd - row) > MAX_CLIQUES_GALLOP_RATIO * (long long)set.size())
+    {
+        for (int v : set)
+        {
+            row = std::lower_bound(row, rowEnd, v);
+            common += (row != rowEnd && *row == v);
+        }
+        return common;
+    }
+    size_t i = 0;
+    while (i < set.size() && row < rowEnd)
+    {
+        if (set[i] < *row)
+        {
+            ++i;
+        }
+        else if (*row < set[i])
+        {
+            ++row;
+        }
+        else
+        {
+            ++common; ++i; ++row;
+        }
+    }
+    return common;
+}
+
+void FindingMaxCliques::intersect(const std::vector<int>& set, int u, std::vector<int>& out) const
+{
+    const int* row = nbr.data() + off[u];
+    const int* rowEnd = nbr.data() + off[u + 1];
+    out.clear();
+    if ((rowEnd - row) > MAX_CLIQUES_GALLOP_RATIO * (long long)set.size())
+    {
+        for (int v : set)
+        {
+            row = std::lower_bound(row, rowEnd, v);
+            if (row != rowEnd && *row == v)
+            {
+                out.push_back(v);
+            }
+        }
+        return;
+    }
+    std::set_intersection(set.begin(), set.end(), row, rowEnd, std::back_inserter(out));
+}
+
+/*
+One Bron-Kerbosch call. P and X live in levelP/levelX[depth]; the call moves each branching
+vertex from P to X after its subtree, as in the textbook version, and builds the sets of the
+next depth in place.
+*/
+void FindingMaxCliques::expand(int depth, const std::function<void(const std::vector<int>&)>& visit)
+{
+    std::vector<int>& P = levelP[depth];
+    std::vector<int>& X = levelX[depth];
+    if (P.empty())
+    {
+        if (X.empty() && (int)clique.size() >= minSize)
+        {
+            // R cannot grow and nothing excluded extends it: it is maximal
+            sorted = clique;
+            std::sort(sorted.begin(), sorted.end());
+            visit(sorted);
+            ++summary.count;
+            if (sorted.size() > summary.maximum.size())
+            {
+                summary.maximum = sorted;
+            }
+        }
+        return;
+    }
+    if ((int)(clique.size() + P.size()) < minSize)
+    {
+        return; // every clique below here is a subset of R + P
+    }
+
+    // Tomita pivot: the vertex of P or X covering the most of P
+    int pivot = -1, best = -1;
+    for (const std::vector<int>* set : {&P, &X})
+    {
+        for (int u : *set)
+        {
+            int c = commonWith(P, u);
+            if (c > best)
+            {
+                best = c;
+                pivot = u;
+            }
+        }
+        if (best == (int)P.size())
+        {
+            break; // cannot be beaten
+        }
+    }
+
+    // Branch only on P \ N(pivot)
+    std::vector<int>& branch = levelBranch[depth];
+    branch.clear();
+    const int* row = nbr.data() + off[pivot];
+    const int* rowEnd = nbr.data() + off[pivot + 1];
+    std::set_difference(P.begin(), P.end(), row, rowEnd, std::back_inserter(branch));
+
+    for (int v : branch)
+    {
+        intersect(P, v, levelP[depth + 1]);
+        intersect(X, v, levelX[depth + 1]);
+        clique.push_back(v);
+        expand(depth + 1, visit);
+        clique.pop_back();
+        P.erase(std::lower_bound(P.begin(), P.end(), v));
+        X.insert(std::lower_bound(X.begin(), X.end(), v), v);
+    }
+}
+
+MaxCliquesSummary FindingMaxCliques::enumerate(const Graph& graph, const std::function<void(const std::vector<int>&)>& visit, int minSize)
+{
+    if (minSize < 1)
+    {
+        throw std::invalid_argument("MIN_SIZE must be at least 1");
+    }
+    this->minSize = minSize;
+    summary = MaxCliquesSummary();
+
+    // Degeneracy order and the symmetric, id-sorted adjacency it was computed on
+    CliqueDag dag = CliqueDag::build(graph);
+    const int n = dag.n;
+    off.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u)
+    {
+        for (int i = dag.offsets[u]; i < dag.offsets[u + 1]; ++i)
+        {
+            ++off[u + 1];
+            ++off[dag.targets[i] + 1];
+        }
+    }
+    for (int u = 0; u < n; ++u)
+    {
+        off[u + 1] += off[u];
+    }
+    nbr.assign(off[n], 0);
+    std::vector<int> pos(off.begin(), off.end() - 1);
+    for (int u = 0; u < n; ++u)
+    {
+        for (int i = dag.offsets[u]; i < dag.offsets[u + 1]; ++i)
+        {
+            nbr[pos[u]++] = dag.targets[i];
+            nbr[pos[dag.targets[i]]++] = u;
+        }
+    }
+    for (int u = 0; u < n; ++u)
+    {
+        std::sort(nbr.begin() + off[u], nbr.begin() + off[u + 1]);
+    }
+
+    std::vector<int> order(n);
+    for (int u = 0; u < n; ++u)
+    {
+        order[dag.rank[u]] = u;
+    }
+
+    // Depth never exceeds the largest clique, which is at most degeneracy + 1
+    levelP.assign(dag.degeneracy + 2, std::vector<int>());
+    levelX.assign(dag.degeneracy + 2, std::vector<int>());
+    levelBranch.assign(dag.degeneracy + 2, std::vector<int>());
+    for (int v : order)
+    {
+        std::vector<int>& P = levelP[0];
+        std::vector<int>& X = levelX[0];
+        P.clear();
+        X.clear();
+        for (int i = off[v]; i < off[v + 1]; ++i)
+        {
+            (dag.rank[nbr[i]] > dag.rank[v] ? P : X).push_back(nbr[i]);
+        }
+        if (1 + (int)P.size() < minSize)
+        {
+            continue;
+        }
+        clique.assign(1, v);
+        expand(0, visit);
+    }
+    clique.clear();
+    return summary;
+}
@@ -0,0 +1,61 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: Maximal clique enumeration (Bron-Kerbosch with Tomita pivoting), following
+Eppstein, Loffler and Strash:
+* The outer level walks the vertices in degeneracy order (CliqueDag). For a vertex v, the
+  candidates P are its later neighbours and the excluded set X its earlier ones, so every maximal
+  clique is found exactly once, from its earliest vertex, and |P| never exceeds the degeneracy.
+* Inside, each call picks the pivot u in P or X with the most neighbours in P and only branches on
+  the candidates that are not neighbours of u (any clique through one of those would be found again).
+Cost is O(d * V * 3^(d/3)) for degeneracy d, which is near-optimal for sparse graphs.
+Adjacency follows the clique counter: u < v are adjacent iff is_edge(u, v) in the graph.
+*/
+
+#pragma once
+
+#include "../part_1/graph_impl.hpp"
+#include "Finding_Num_Cliques.hpp"
+
+#include <functional>
+#include <vector>
+
+// What an enumeration found besides the cliques themselves
+struct MaxCliquesSummary
+{
+    long long count = 0;        // maximal cliques reported
+    std::vector<int> maximum;   // one largest clique (sorted), empty if nothing was reported
+};
+
+class FindingMaxCliques
+{
+public:
+    /*
+    Calls visit(clique) once per maximal clique of at least minSize vertices, with the vertices
+    sorted by id. Branches that cannot reach minSize are cut off, so a large minSize also makes
+    the search faster. Throws std::invalid_argument if minSize < 1.
+    */
+    MaxCliquesSummary enumerate(const Graph& graph, const std::function<void(const std::vector<int>&)>& visit, int minSize = 1);
+
+private:
+    // Symmetric adjacency: nbr[off[u] .. off[u+1]) sorted by id
+    std::vector<int> off, nbr;
+
+    // Candidate (P), excluded (X) and branching sets of each recursion depth, reused between calls
+    std::vector<std::vector<int>> levelP, levelX, levelBranch;
+
+    std::vector<int> clique; // R, in the order it was built
+    std::vector<int> sorted; // R sorted, handed to visit
+    int minSize = 1;
+    MaxCliquesSummary summary;
+
+    // Number of common vertices of an id-sorted set and the neighbours of u
+    int commonWith(const std::vector<int>& set, int u) const;
+
+    // Keeps in 'out' the members of 'set' adjacent to u
+    void intersect(const std::vector<int>& set, int u, std::vector<int>& out) const;
+
+    // Bron-Kerbosch step with R = clique, P = levelP[depth], X = levelX[depth]
+    void expand(int depth, const std::function<void(const std::vector<int>&)>& visit);
+};
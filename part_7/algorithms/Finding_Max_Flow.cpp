@@ -1,15 +1,64 @@
 #include "Finding_Max_Flow.hpp"
+#include "Team_Barrier.hpp"
+#include <atomic>
 
-int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink) 
+/*
+Builds the residual network in CSR form from the graph's arcs:
+*Every arc u->v with capacity c becomes a forward residual arc (capacity c)
+and a paired backward arc v->u (capacity 0).
+*rev[a] is the index of the arc paired with a, so pushing flow on a is
+cap[a] -= f; cap[rev[a]] += f.
+Memory is O(V + E), independent of how dense the vertex range is.
+*/
+static void buildResidual(const Graph& g, std::vector<int>& head, std::vector<int>& to,
+                          std::vector<int>& cap, std::vector<int>& rev)
 {
     int V = g.get_vertices();
+    const IntSpan offsets = g.get_offsets();
+    const IntSpan targets = g.get_targets();
+    const IntSpan weights = g.get_weights();
+    int arcs = targets.size();
 
-    // Copy the capacity matrix from the graph
-    // Capacity[u][v] = capacity of edge u->v
-    std::vector<std::vector<int>> residual = g.get_capacity();
+    head.assign(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+    {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            ++head[u + 1];          // forward arc lives at u
+            ++head[targets[i] + 1]; // backward arc lives at v
+        }
+    }
+    for (int u = 0; u < V; ++u)
+    {
+        head[u + 1] += head[u];
+    }
+
+    to.assign(2 * arcs, 0);
+    cap.assign(2 * arcs, 0);
+    rev.assign(2 * arcs, 0);
+    std::vector<int> pos(head.begin(), head.end() - 1);
+    for (int u = 0; u < V; ++u)
+    {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            int v = targets[i];
+            int a = pos[u]++;
+            int b = pos[v]++;
+            to[a] = v; cap[a] = weights[i]; rev[a] = b;
+            to[b] = u; cap[b] = 0;          rev[b] = a;
+        }
+    }
+}
 
+/*
+Edmonds-Karp on the residual network (arcs of u are head[u]..head[u+1] in to/residual/rev).
+*/
+static int edmondsKarp(int V, const std::vector<int>& head, const std::vector<int>& to,
+                       std::vector<int>& residual, const std::vector<int>& rev, int source, int sink)
+{
     int maxFlow = 0;
     std::vector<int> parent(V); // To store the path
+    std::vector<int> parentArc(V); // Residual arc used to reach each vertex
 
     /*               
     Breadth-First Search (BFS) to find an augmenting path using a lambda function:
@@ -45,12 +94,14 @@ int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink)
             q.pop(); removes that node from the queue, so it's possible to process the next one in the following iteration.
             */
             int u = q.front(); q.pop();
-            for (int v = 0; v < V; ++v) 
+            for (int a = head[u]; a < head[u + 1]; ++a) 
             {
+                int v = to[a];
                 // Check if the parent of v is not assigned and there's available capacity
-                if (parent[v] == -1 && residual[u][v] > 0) 
+                if (parent[v] == -1 && residual[a] > 0) 
                 {
                     parent[v] = u; // Set parent of v to u (u-->v in the path)
+                    parentArc[v] = a;
                     if (v == t) return true; // If we reached the sink, return true
                     q.push(v); // Add v to the BFS queue
                 }
@@ -70,17 +121,631 @@ int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink)
         int path_flow = INT_MAX; // Initialize path flow to a large value
         for (int v = sink; v != source; v = parent[v]) 
         {
-            int u = parent[v];
-            path_flow = std::min(path_flow, residual[u][v]);
+            path_flow = std::min(path_flow, residual[parentArc[v]]);
         }
         // Update residual capacities
         for (int v = sink; v != source; v = parent[v]) 
         {
-            int u = parent[v];
-            residual[u][v] -= path_flow;
-            residual[v][u] += path_flow;
+            int a = parentArc[v];
+            residual[a] -= path_flow;
+            residual[rev[a]] += path_flow;
         }
         maxFlow += path_flow;
     }
     return maxFlow;
-}
\ No newline at end of file
+}
+
+/*
+Dinic's algorithm on the same residual network.
+
+Each phase:
+1. BFS from the source assigns level[v] = residual distance from the source; stop if the sink is unreachable.
+2. Blocking flow: walk forward along admissible arcs (residual > 0 and level[to] == level[u] + 1),
+   remembering the path as a stack of arcs. it[u] is u's current-arc pointer: an arc that once led
+   to a dead end or got saturated is never looked at again during this phase.
+   * Reaching the sink: push the bottleneck along the path and retreat to the tail of the first
+     saturated arc.
+   * Dead end at u: drop the last arc of the path and advance the pointer of its tail.
+The walk is iterative, so long augmenting paths on 100k-vertex graphs cannot overflow the call stack.
+*/
+static int dinic(int V, const std::vector<int>& head, const std::vector<int>& to,
+                 std::vector<int>& residual, const std::vector<int>& rev, int source, int sink)
+{
+    if (source == sink)
+    {
+        return 0;
+    }
+    int maxFlow = 0;
+    std::vector<int> level(V);
+    std::vector<int> it(V);
+    std::vector<int> queue(V);
+    std::vector<int> path; // arcs from the source to the current vertex
+
+    auto bfs = [&]() -> bool
+    {
+        std::fill(level.begin(), level.end(), -1);
+        int qh = 0, qt = 0;
+        queue[qt++] = source;
+        level[source] = 0;
+        while (qh < qt)
+        {
+            int u = queue[qh++];
+            for (int a = head[u]; a < head[u + 1]; ++a)
+            {
+                int v = to[a];
+                if (level[v] < 0 && residual[a] > 0)
+                {
+                    level[v] = level[u] + 1;
+                    queue[qt++] = v;
+                }
+            }
+        }
+        return level[sink] >= 0;
+    };
+
+    while (bfs())
+    {
+        std::copy(head.begin(), head.end() - 1, it.begin());
+        path.clear();
+        int u = source;
+        while (true)
+        {
+            if (u == sink)
+            {
+                int pathFlow = INT_MAX;
+                for (int a : path)
+                {
+                    pathFlow = std::min(pathFlow, residual[a]);
+                }
+                for (int a : path)
+                {
+                    residual[a] -= pathFlow;
+                    residual[rev[a]] += pathFlow;
+                }
+                maxFlow += pathFlow;
+
+                // Retreat to the tail of the first saturated arc
+                size_t k = 0;
+                while (residual[path[k]] > 0)
+                {
+                    ++k;
+                }
+                path.resize(k);
+                u = path.empty() ? source : to[path.back()];
+                continue;
+            }
+
+            int& a = it[u];
+            while (a < head[u + 1] && !(residual[a] > 0 && level[to[a]] == level[u] + 1))
+            {
+                ++a;
+            }
+            if (a < head[u + 1])
+            {
+                path.push_back(a); // advance
+                u = to[a];
+            }
+            else
+            {
+                if (u == source)
+                {
+                    break; // blocking flow reached
+                }
+                level[u] = -1;  // dead end: nothing useful left behind u in this phase
+                path.pop_back(); // retreat
+                u = path.empty() ? source : to[path.back()];
+                ++it[u];
+            }
+        }
+    }
+    return maxFlow;
+}
+
+/*
+Highest-label push-relabel (Goldberg-Tarjan) on the same residual network.
+
+Instead of augmenting whole paths, every vertex may hold excess flow and pushes it to a neighbour
+one level closer to the sink (height[to] == height[u] - 1). A vertex that cannot push is relabeled to
+one above its lowest residual neighbour. Always discharging the highest active vertex keeps the
+number of pushes low, O(V^2 * sqrt(E)).
+Two heuristics keep the heights close to the real distances:
+* Global relabel: a backward BFS from the sink resets every height to the exact residual distance.
+  It runs at the start and again whenever the relabel work since the last one exceeds ~6V + E.
+* Gap: when relabeling empties a height h, no vertex above h can reach the sink any more, so they
+  are all lifted to V at once and left alone.
+Only the first phase (max preflow) is run: the excess that reaches the sink is the max-flow value.
+Vertices that cannot reach the sink keep their excess; it never changes the flow value.
+*/
+static int pushRelabel(int V, const std::vector<int>& head, const std::vector<int>& to,
+                       std::vector<int>& residual, const std::vector<int>& rev, int source, int sink)
+{
+    if (source == sink)
+    {
+        return 0;
+    }
+    const int n = V;
+    std::vector<int> height(n, n);
+    std::vector<long long> excess(n, 0);
+    std::vector<int> cur(n); // current-arc pointer of each vertex
+
+    // Active vertices per height (stacks) and all vertices below height n per height (doubly linked lists)
+    std::vector<int> activeHead(n, -1), activeNext(n, -1);
+    std::vector<int> bucketHead(n, -1), bucketNext(n, -1), bucketPrev(n, -1);
+    int maxActive = -1; // highest height that may hold an active vertex
+    int maxHeight = -1; // highest height that may hold any vertex
+
+    auto activate = [&](int v)
+    {
+        activeNext[v] = activeHead[height[v]];
+        activeHead[height[v]] = v;
+        maxActive = std::max(maxActive, height[v]);
+    };
+    auto bucketInsert = [&](int v)
+    {
+        int h = height[v];
+        bucketPrev[v] = -1;
+        bucketNext[v] = bucketHead[h];
+        if (bucketHead[h] >= 0)
+        {
+            bucketPrev[bucketHead[h]] = v;
+        }
+        bucketHead[h] = v;
+        maxHeight = std::max(maxHeight, h);
+    };
+    auto bucketRemove = [&](int v)
+    {
+        if (bucketPrev[v] >= 0)
+        {
+            bucketNext[bucketPrev[v]] = bucketNext[v];
+        }
+        else
+        {
+            bucketHead[height[v]] = bucketNext[v];
+        }
+        if (bucketNext[v] >= 0)
+        {
+            bucketPrev[bucketNext[v]] = bucketPrev[v];
+        }
+    };
+
+    std::vector<int> queue(n);
+    auto globalRelabel = [&]()
+    {
+        std::fill(height.begin(), height.end(), n);
+        std::fill(activeHead.begin(), activeHead.end(), -1);
+        std::fill(bucketHead.begin(), bucketHead.end(), -1);
+        maxActive = maxHeight = -1;
+        int qh = 0, qt = 0;
+        height[sink] = 0;
+        queue[qt++] = sink;
+        while (qh < qt)
+        {
+            int u = queue[qh++];
+            bucketInsert(u);
+            for (int a = head[u]; a < head[u + 1]; ++a)
+            {
+                int v = to[a];
+                // v -> u still has residual capacity (rev[a] is the arc v -> u)
+                if (height[v] == n && v != source && residual[rev[a]] > 0)
+                {
+                    height[v] = height[u] + 1;
+                    queue[qt++] = v;
+                }
+            }
+        }
+        for (int v = 0; v < n; ++v)
+        {
+            if (height[v] < n)
+            {
+                cur[v] = head[v];
+                if (excess[v] > 0 && v != sink)
+                {
+                    activate(v);
+                }
+            }
+        }
+    };
+
+    // Saturate every arc out of the source
+    for (int a = head[source]; a < head[source + 1]; ++a)
+    {
+        int f = residual[a];
+        residual[a] = 0;
+        residual[rev[a]] += f;
+        excess[to[a]] += f;
+    }
+    globalRelabel();
+
+    const long long relabelEvery = 6LL * n + (long long)to.size();
+    long long work = 0;
+    while (maxActive >= 0)
+    {
+        int u = activeHead[maxActive];
+        if (u < 0)
+        {
+            --maxActive;
+            continue;
+        }
+        activeHead[maxActive] = activeNext[u];
+        if (height[u] != maxActive)
+        {
+            continue; // stale entry: u was lifted by a gap
+        }
+
+        // Discharge u: push along admissible arcs, relabel when there are none left
+        while (excess[u] > 0)
+        {
+            int& a = cur[u];
+            const int end = head[u + 1];
+            while (a < end && !(residual[a] > 0 && height[to[a]] == height[u] - 1))
+            {
+                ++a;
+            }
+            if (a < end)
+            {
+                int v = to[a];
+                int d = (int)std::min<long long>(excess[u], residual[a]);
+                residual[a] -= d;
+                residual[rev[a]] += d;
+                excess[u] -= d;
+                if (excess[v] == 0 && v != sink)
+                {
+                    excess[v] = d;
+                    activate(v);
+                }
+                else
+                {
+                    excess[v] += d;
+                }
+                continue;
+            }
+
+            // Relabel
+            work += 12 + (end - head[u]);
+            int oldHeight = height[u];
+            int newHeight = n;
+            for (int b = head[u]; b < end; ++b)
+            {
+                if (residual[b] > 0)
+                {
+                    newHeight = std::min(newHeight, height[to[b]] + 1);
+                }
+            }
+            bucketRemove(u);
+            if (bucketHead[oldHeight] < 0)
+            {
+                // Gap at oldHeight: everything above it (u included) is cut off from the sink
+                for (int h = oldHeight + 1; h <= maxHeight; ++h)
+                {
+                    for (int v = bucketHead[h]; v >= 0; v = bucketNext[v])
+                    {
+                        height[v] = n;
+                    }
+                    bucketHead[h] = -1;
+                }
+                maxHeight = oldHeight - 1;
+                height[u] = n;
+                break;
+            }
+            height[u] = newHeight;
+            if (newHeight >= n)
+            {
+                break; // u cannot reach the sink any more
+            }
+            cur[u] = head[u];
+            bucketInsert(u);
+        }
+
+        if (work > relabelEvery)
+        {
+            globalRelabel();
+            work = 0;
+        }
+    }
+    return (int)excess[sink];
+}
+
+/*
+Synchronous parallel push-relabel: every active vertex is processed at once, in rounds.
+Each round has four steps separated by barriers:
+1. Push:    each active v pushes along admissible arcs (height[w] == height[v] - 1), using the
+            heights fixed at the start of the round. Excess sent to w goes into an atomic counter
+            added[w], so w's own excess is only ever touched by w.
+2. Relabel: each v that still has excess computes its new height from the round-start heights
+            into newHeight[v] (nobody writes residuals or heights in this step).
+3. Commit:  height[v] = newHeight[v].
+4. Thread 0 merges the added excess and builds the next active set; it also runs the global
+   relabel (backward BFS from the sink) when enough relabel work piled up.
+Why the push step needs no locks: v reads or writes the arc pair {v->w, w->v} only when
+height[w] == height[v] - 1, and w would touch the same pair only when height[v] == height[w] - 1.
+Both cannot hold in the same round, so every arc pair has a single owner per round.
+The flow value does not depend on the number of threads.
+*/
+static int parallelPushRelabel(int V, const std::vector<int>& head, const std::vector<int>& to,
+                               std::vector<int>& residual, const std::vector<int>& rev, int source, int sink, int threads)
+{
+    if (source == sink)
+    {
+        return 0;
+    }
+    const int n = V;
+    std::vector<int> height(n, n), newHeight(n, n);
+    std::vector<long long> excess(n, 0);
+    std::vector<std::atomic<long long>> added(n);
+    for (auto& x : added)
+    {
+        x.store(0, std::memory_order_relaxed);
+    }
+    std::vector<char> queued(n, 0);
+    std::vector<int> active, next;
+    std::vector<int> queue(n);
+
+    auto globalRelabel = [&]()
+    {
+        std::fill(height.begin(), height.end(), n);
+        int qh = 0, qt = 0;
+        height[sink] = 0;
+        queue[qt++] = sink;
+        while (qh < qt)
+        {
+            int u = queue[qh++];
+            for (int a = head[u]; a < head[u + 1]; ++a)
+            {
+                int v = to[a];
+                if (height[v] == n && v != source && residual[rev[a]] > 0)
+                {
+                    height[v] = height[u] + 1;
+                    queue[qt++] = v;
+                }
+            }
+        }
+        active.clear();
+        for (int v = 0; v < n; ++v)
+        {
+            if (height[v] < n && excess[v] > 0 && v != sink)
+            {
+                active.push_back(v);
+            }
+        }
+    };
+
+    // Saturate every arc out of the source
+    for (int a = head[source]; a < head[source + 1]; ++a)
+    {
+        int f = residual[a];
+        residual[a] = 0;
+        residual[rev[a]] += f;
+        excess[to[a]] += f;
+    }
+    globalRelabel();
+
+    const long long relabelEvery = 6LL * n + (long long)to.size();
+    std::atomic<long long> work{0};
+    bool done = active.empty();
+    std::vector<std::vector<int>> received(threads); // per thread: vertices whose added[] went 0 -> positive
+    TeamBarrier barrier(threads);
+
+    auto worker = [&](int tid)
+    {
+        while (true)
+        {
+            barrier.wait(); // round start: 'active' and 'done' are ready
+            if (done)
+            {
+                return;
+            }
+            const size_t lo = active.size() * tid / threads;
+            const size_t hi = active.size() * (tid + 1) / threads;
+
+            // 1) Push
+            for (size_t i = lo; i < hi; ++i)
+            {
+                int v = active[i];
+                for (int a = head[v]; a < head[v + 1] && excess[v] > 0; ++a)
+                {
+                    int w = to[a];
+                    if (height[w] == height[v] - 1 && residual[a] > 0) // heights first: see the ownership note above
+                    {
+                        int d = (int)std::min<long long>(excess[v], residual[a]);
+                        residual[a] -= d;
+                        residual[rev[a]] += d;
+                        excess[v] -= d;
+                        if (added[w].fetch_add(d, std::memory_order_relaxed) == 0)
+                        {
+                            received[tid].push_back(w);
+                        }
+                    }
+                }
+            }
+            barrier.wait();
+
+            // 2) Relabel (round-start heights in, newHeight out)
+            long long localWork = 0;
+            for (size_t i = lo; i < hi; ++i)
+            {
+                int v = active[i];
+                newHeight[v] = height[v];
+                if (excess[v] > 0)
+                {
+                    int h = n;
+                    for (int a = head[v]; a < head[v + 1]; ++a)
+                    {
+                        if (residual[a] > 0)
+                        {
+                            h = std::min(h, height[to[a]] + 1);
+                        }
+                    }
+                    newHeight[v] = h;
+                    localWork += 12 + (head[v + 1] - head[v]);
+                }
+            }
+            work.fetch_add(localWork, std::memory_order_relaxed);
+            barrier.wait();
+
+            // 3) Commit
+            for (size_t i = lo; i < hi; ++i)
+            {
+                height[active[i]] = newHeight[active[i]];
+            }
+            barrier.wait();
+
+            // 4) Next active set
+            if (tid == 0)
+            {
+                next.clear();
+                for (int v : active)
+                {
+                    if (excess[v] > 0 && height[v] < n && !queued[v])
+                    {
+                        queued[v] = 1;
+                        next.push_back(v);
+                    }
+                }
+                for (auto& list : received)
+                {
+                    for (int w : list)
+                    {
+                        excess[w] += added[w].exchange(0, std::memory_order_relaxed);
+                        if (w != sink && height[w] < n && !queued[w])
+                        {
+                            queued[w] = 1;
+                            next.push_back(w);
+                        }
+                    }
+                    list.clear();
+                }
+                for (int v : next)
+                {
+                    queued[v] = 0;
+                }
+                active.swap(next);
+                if (work.load(std::memory_order_relaxed) > relabelEvery)
+                {
+                    globalRelabel();
+                    work.store(0, std::memory_order_relaxed);
+                }
+                done = active.empty();
+            }
+        }
+    };
+
+    runTeam(threads, worker);
+    return (int)excess[sink];
+}
+
+/*
+Sparse graphs (fewer than a quarter of all possible arcs) go to Dinic, dense ones to push-relabel:
+on a dense high-capacity network Edmonds-Karp needs so many augmenting paths that it is
+tens of times slower than either.
+*/
+MaxFlowEngine FindingMaxFlow::chooseEngine(const Graph& g)
+{
+    long long V = g.get_vertices();
+    return (long long)g.get_arcs() * 4 < V * (V - 1) ? MAXFLOW_DINIC : MAXFLOW_PUSH_RELABEL;
+}
+
+/*
+Runs the chosen engine on a freshly built residual network and returns the flow value.
+The residual arrays are left in their final state for the caller (findMinCut reads them).
+*/
+static int runEngine(const Graph& g, int source, int sink, MaxFlowEngine engine, int threads,
+                     std::vector<int>& head, std::vector<int>& to, std::vector<int>& residual, std::vector<int>& rev)
+{
+    int V = g.get_vertices();
+    if (source < 0 || source >= V || sink < 0 || sink >= V)
+    {
+        throw std::out_of_range("source/sink out of range");
+    }
+
+    // Residual network (sparse): arcs of u are head[u]..head[u+1] in to/residual/rev
+    buildResidual(g, head, to, residual, rev);
+
+    if (engine == MAXFLOW_AUTO)
+    {
+        engine = FindingMaxFlow::chooseEngine(g);
+    }
+    if (engine == MAXFLOW_DINIC)
+    {
+        return dinic(V, head, to, residual, rev, source, sink);
+    }
+    if (engine == MAXFLOW_PUSH_RELABEL)
+    {
+        return pushRelabel(V, head, to, residual, rev, source, sink);
+    }
+    if (engine == MAXFLOW_PARALLEL_PUSH_RELABEL)
+    {
+        return parallelPushRelabel(V, head, to, residual, rev, source, sink, teamSize(threads));
+    }
+    return edmondsKarp(V, head, to, residual, rev, source, sink);
+}
+
+int FindingMaxFlow::findMaxFlow(const Graph& g, int source, int sink, MaxFlowEngine engine, int threads)
+{
+    std::vector<int> head, to, residual, rev;
+    return runEngine(g, source, sink, engine, threads, head, to, residual, rev);
+}
+
+/*
+The sink side is every vertex that can still reach the sink in the final residual network
+(backward BFS from the sink over arcs with residual capacity); the source side is the rest.
+This works for all engines: the push-relabel engines stop at a maximum preflow, where the
+vertices reachable from the source are not a valid cut, but "cannot reach the sink" still is.
+Every original arc from the source side to the sink side is saturated, so their capacities
+add up to the flow value. Cost on top of the engine: one O(V + E) BFS and one pass over the arcs.
+*/
+MinCut FindingMaxFlow::findMinCut(const Graph& g, int source, int sink, MaxFlowEngine engine, int threads)
+{
+    if (source == sink)
+    {
+        throw std::invalid_argument("source and sink must be different");
+    }
+    std::vector<int> head, to, residual, rev;
+    MinCut cut;
+    cut.flow = runEngine(g, source, sink, engine, threads, head, to, residual, rev);
+
+    int V = g.get_vertices();
+    std::vector<char> reachesSink(V, 0);
+    std::vector<int> queue(V);
+    int qh = 0, qt = 0;
+    reachesSink[sink] = 1;
+    queue[qt++] = sink;
+    while (qh < qt)
+    {
+        int u = queue[qh++];
+        for (int a = head[u]; a < head[u + 1]; ++a)
+        {
+            int v = to[a];
+            if (!reachesSink[v] && residual[rev[a]] > 0) // rev[a] is the arc v -> u
+            {
+                reachesSink[v] = 1;
+                queue[qt++] = v;
+            }
+        }
+    }
+
+    cut.sourceSide.assign(V, 0);
+    for (int v = 0; v < V; ++v)
+    {
+        cut.sourceSide[v] = !reachesSink[v];
+    }
+
+    // Original arcs crossing from the source side to the sink side (an undirected edge crosses in one direction only)
+    const IntSpan offsets = g.get_offsets();
+    const IntSpan targets = g.get_targets();
+    const IntSpan weights = g.get_weights();
+    for (int u = 0; u < V; ++u)
+    {
+        if (!cut.sourceSide[u])
+        {
+            continue;
+        }
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            if (!cut.sourceSide[targets[i]])
+            {
+                cut.edges.push_back({u, targets[i], weights[i]});
+            }
+        }
+    }
+    return cut;
+}
@@ -4,10 +4,21 @@
 
 @date: 14-10-2025
 
-@description: Finding Max Flow in a flow network using Edmonds-Karp algorithm 
-(an implementation of Ford-Fulkerson method using BFS)
-The algorithm repeatedly finds the shortest augmenting path from source to sink using BFS
-and augments the flow along that path until no more augmenting paths can be found.
+@description: Finding Max Flow in a flow network.
+Two engines share one residual network, kept as paired forward/backward arc arrays built from the
+graph's CSR, so memory is O(V + E) instead of O(V^2):
+* Edmonds-Karp (an implementation of Ford-Fulkerson method using BFS): repeatedly finds the shortest
+  augmenting path from source to sink using BFS and augments the flow along it. O(V * E^2).
+* Dinic: builds a BFS level graph from the source and saturates it with a blocking flow
+  (DFS with a current-arc pointer per vertex), then rebuilds the levels. O(V^2 * E) in general
+  and much faster on sparse networks, where each phase is close to linear.
+* Push-relabel (highest label, with global relabeling and the gap heuristic): moves excess flow
+  vertex by vertex instead of along whole paths, which suits dense, high-capacity networks
+  where augmenting-path methods need very many paths.
+* Parallel push-relabel: a synchronous variant that pushes from / relabels all active vertices
+  at once in rounds, split over a team of threads (see Finding_Max_Flow.cpp for why it needs no locks).
+MAXFLOW_AUTO picks Dinic for sparse graphs and push-relabel for dense ones.
+findMinCut also returns a minimum s-t cut, read off the engine's final residual network.
 */
 
 #pragma once
@@ -17,8 +28,36 @@ and augments the flow along that path until no more augmenting paths can be foun
 #include <vector>
 #include <climits>
 
+// Max-flow engine selector (also accepted as "PARAM ENGINE <n>" by MaxFlowAlgo)
+enum MaxFlowEngine
+{
+    MAXFLOW_AUTO = 0,
+    MAXFLOW_EDMONDS_KARP = 1,
+    MAXFLOW_DINIC = 2,
+    MAXFLOW_PUSH_RELABEL = 3,
+    MAXFLOW_PARALLEL_PUSH_RELABEL = 4
+};
+
+// A minimum s-t cut together with the max-flow value
+struct MinCut
+{
+    int flow = 0;
+    std::vector<char> sourceSide;  // sourceSide[v] != 0 iff v is on the source side
+    std::vector<GraphEdge> edges;  // arcs from the source side to the sink side; their capacities sum to flow
+};
+
 class FindingMaxFlow 
 {
 public:
-    int findMaxFlow(Graph& g, int source, int sink);
-};
\ No newline at end of file
+    /*
+    Throws std::out_of_range if source or sink is not a vertex of g.
+    'threads' is only used by MAXFLOW_PARALLEL_PUSH_RELABEL (0 = hardware concurrency; capped at it).
+    */
+    int findMaxFlow(const Graph& g, int source, int sink, MaxFlowEngine engine = MAXFLOW_AUTO, int threads = 0);
+
+    // Max flow plus a minimum cut from the same run. Also throws std::invalid_argument if source == sink.
+    MinCut findMinCut(const Graph& g, int source, int sink, MaxFlowEngine engine = MAXFLOW_AUTO, int threads = 0);
+
+    // The engine MAXFLOW_AUTO resolves to for g
+    static MaxFlowEngine chooseEngine(const Graph& g);
+};
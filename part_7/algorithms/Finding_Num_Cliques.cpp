@@ -1,54 +1,841 @@
 #include "Finding_Num_Cliques.hpp"
+#include "Team_Barrier.hpp"
+#include <iterator>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CLIQUES_HAVE_AVX2_PATH 1
+#endif
 
+// Largest per-root bit matrix the automatic kernel choice accepts for the bitset kernel
+#define CLIQUES_BITSET_MAX_BYTES (64LL << 20)
 
-// Helper function to check if a set of vertices forms a clique
-static bool isClique(const Graph& graph, const std::vector<int>& vertices) 
+// Samples an estimate needs before the EPS rule may stop it (the normal approximation is poor below)
+#define CLIQUES_APPROX_MIN_SAMPLES 100
+
+/*
+Builds the DAG in three passes:
+1. Simple undirected adjacency: the pairs {u, v}, u < v, that the clique test accepts
+   (duplicates and self-loops dropped), stored both ways with every row sorted by id.
+2. Degeneracy order (Batagelj-Zaversnik bucket sort): vertices sit in buckets by current degree;
+   the vertex taken from the lowest non-empty bucket gets the next rank, and its unranked
+   neighbours move down one bucket. O(V + E).
+3. out(u) = neighbours of higher rank, read from the sorted row, so it stays sorted by id.
+*/
+CliqueDag CliqueDag::build(const Graph& graph)
 {
-	for (size_t i = 0; i < vertices.size(); ++i) 
+    const int n = graph.get_vertices();
+    const IntSpan offsets = graph.get_offsets();
+    const IntSpan targets = graph.get_targets();
+
+    // 1) Pairs u < v in lexicographic order (CSR rows are sorted), then symmetric rows.
+    //    An undirected edge is stored both ways, and only its u -> v copy with u < v is taken;
+    //    a directed arc counts only if it leaves the smaller id, as is_edge(u, v) with u < v requires.
+    std::vector<int> pairU, pairV;
+    for (int u = 0; u < n; ++u)
+    {
+        int last = -1;
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            int v = targets[i];
+            if (v > u && v != last)
+            {
+                pairU.push_back(u);
+                pairV.push_back(v);
+                last = v;
+            }
+        }
+    }
+    std::vector<int> adjOff(n + 1, 0);
+    for (size_t e = 0; e < pairU.size(); ++e)
+    {
+        ++adjOff[pairU[e] + 1];
+        ++adjOff[pairV[e] + 1];
+    }
+    for (int u = 0; u < n; ++u)
+    {
+        adjOff[u + 1] += adjOff[u];
+    }
+    std::vector<int> adj(adjOff[n]);
+    std::vector<int> pos(adjOff.begin(), adjOff.end() - 1);
+    for (size_t e = 0; e < pairU.size(); ++e)
+    {
+        // Lexicographic pair order puts a row's smaller neighbours before its larger ones, both ascending
+        adj[pos[pairU[e]]++] = pairV[e];
+        adj[pos[pairV[e]]++] = pairU[e];
+    }
+
+    // 2) Degeneracy order
+    std::vector<int> deg(n), bin, vert(n), where(n);
+    int maxDeg = 0;
+    for (int u = 0; u < n; ++u)
+    {
+        deg[u] = adjOff[u + 1] - adjOff[u];
+        maxDeg = std::max(maxDeg, deg[u]);
+    }
+    bin.assign(maxDeg + 1, 0);
+    for (int u = 0; u < n; ++u)
+    {
+        ++bin[deg[u]];
+    }
+    for (int d = 0, start = 0; d <= maxDeg; ++d)
+    {
+        int count = bin[d];
+        bin[d] = start; // first slot of bucket d
+        start += count;
+    }
+    for (int u = 0; u < n; ++u)
+    {
+        where[u] = bin[deg[u]]++;
+        vert[where[u]] = u;
+    }
+    for (int d = maxDeg; d > 0; --d)
+    {
+        bin[d] = bin[d - 1];
+    }
+    bin[0] = 0;
+
+    CliqueDag dag;
+    dag.n = n;
+    dag.rank.assign(n, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        int u = vert[i];
+        dag.rank[u] = i;
+        for (int j = adjOff[u]; j < adjOff[u + 1]; ++j)
+        {
+            int v = adj[j];
+            if (deg[v] > deg[u])
+            {
+                // Move v to the front of its bucket, then shrink the bucket past it
+                int dv = deg[v];
+                int first = bin[dv];
+                int w = vert[first];
+                if (w != v)
+                {
+                    std::swap(vert[first], vert[where[v]]);
+                    where[w] = where[v];
+                    where[v] = first;
+                }
+                ++bin[dv];
+                --deg[v];
+            }
+        }
+    }
+
+    // 3) Out-neighbours by rank
+    dag.offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u)
+    {
+        int out = 0;
+        for (int j = adjOff[u]; j < adjOff[u + 1]; ++j)
+        {
+            out += dag.rank[adj[j]] > dag.rank[u];
+        }
+        dag.offsets[u + 1] = dag.offsets[u] + out;
+        dag.degeneracy = std::max(dag.degeneracy, out);
+    }
+    dag.targets.resize(dag.offsets[n]);
+    for (int u = 0, k = 0; u < n; ++u)
     {
-		for (size_t j = i + 1; j < vertices.size(); ++j) 
+        for (int j = adjOff[u]; j < adjOff[u + 1]; ++j)
         {
-			if (!graph.is_edge(vertices[i], vertices[j])) 
+            if (dag.rank[adj[j]] > dag.rank[u])
             {
-				return false;
-			}
-		}
-	}
-	return true;
+                dag.targets[k++] = adj[j];
+            }
+        }
+    }
+    return dag;
 }
 
+// Number of common elements of two id-sorted lists
+static int countCommon(const int* a, const int* aEnd, const int* b, const int* bEnd)
+{
+    int common = 0;
+    while (a < aEnd && b < bEnd)
+    {
+        if (*a < *b)
+        {
+            ++a;
+        }
+        else if (*b < *a)
+        {
+            ++b;
+        }
+        else
+        {
+            ++common; ++a; ++b;
+        }
+    }
+    return common;
+}
+
+// Stop policy of countIn for counts that always run to the end
+struct NeverStop
+{
+    bool operator()() const { return false; }
+};
+
+// Stop policy of countIn that gives up once a deadline has passed (the clock is read every 256 branches)
+struct DeadlineStop
+{
+    std::chrono::steady_clock::time_point deadline;
+    unsigned ticks = 0;
+    bool expired = false;
+
+    bool operator()()
+    {
+        if (!expired && (++ticks & 255) == 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            expired = true;
+        }
+        return expired;
+    }
+};
+
 /*
-This function recursively generates all possible combinations of k vertices from the graph:
-*If the current combination (current) has k vertices,
-it checks if they form a clique and returns 1 if true, 0 otherwise.
-*Otherwise, it tries adding each vertex (from start to n-1) to current,
-recursing to build larger combinations.
-*After each recursive call, it removes the last vertex to backtrack.
-*The sum of all recursive calls gives the total number of k-cliques.
+Cliques of 'need' more vertices inside 'cand' (every vertex of cand is adjacent to the clique
+built so far). Each step picks v in cand and keeps cand ∩ out(v); since out(v) only holds
+vertices ranked above v, each clique is reached through exactly one ordering.
+At need == 2 the last two levels collapse into counting |cand ∩ out(v)| without building it.
+outOf(v) gives out(v) as an id-sorted [begin, end) pair; cand must hold no repeated vertex, while
+out(v) may (the intersections then still keep each common vertex once).
+stop() is asked before every branch; once it returns true the walk unwinds and the returned
+total is partial (the exact count passes NeverStop, which compiles away).
 */
+template <typename OutOf, typename Stop>
+static long long countIn(const OutOf& outOf, const std::vector<int>& cand, int need, std::vector<std::vector<int>>& scratch, Stop& stop)
+{
+    if (need == 1)
+    {
+        return (long long)cand.size();
+    }
+    long long total = 0;
+    for (int v : cand)
+    {
+        if (stop())
+        {
+            return total;
+        }
+        const std::pair<const int*, const int*> out = outOf(v);
+        const int* o = out.first;
+        const int* oEnd = out.second;
+        if (oEnd - o < need - 1)
+        {
+            continue; // too few higher neighbours to finish a clique
+        }
+        if (need == 2)
+        {
+            total += countCommon(o, oEnd, cand.data(), cand.data() + cand.size());
+            continue;
+        }
+        std::vector<int>& next = scratch[need];
+        next.clear();
+        std::set_intersection(o, oEnd, cand.begin(), cand.end(), std::back_inserter(next));
+        if ((int)next.size() >= need - 1)
+        {
+            total += countIn(outOf, next, need - 1, scratch, stop);
+        }
+    }
+    return total;
+}
 
-static int countCliquesRecursive(const Graph& graph, int k, int start, std::vector<int>& current) 
+long long FindingNumCliques::countFromRoot(const CliqueDag& dag, int u, int k, std::vector<std::vector<int>>& scratch)
 {
-	if (static_cast<int>(current.size()) == k) 
+    if (k == 1)
     {
-		return isClique(graph, current) ? 1 : 0;
-	}
-	int count = 0;
-	int n = graph.get_vertices();
-	for (int v = start; v < n; ++v) 
+        return 1;
+    }
+    if ((int)scratch.size() < k + 1)
     {
-		current.push_back(v);
-		count += countCliquesRecursive(graph, k, v + 1, current); //Calling itself recursively to build combinations.
-		current.pop_back();
-	}
-	return count;
+        scratch.resize(k + 1);
+    }
+    std::vector<int>& cand = scratch[k];
+    cand.assign(dag.targets.begin() + dag.offsets[u], dag.targets.begin() + dag.offsets[u + 1]);
+    const int* t = dag.targets.data();
+    auto outOf = [&dag, t](int v) { return std::make_pair(t + dag.offsets[v], t + dag.offsets[v + 1]); };
+    NeverStop never;
+    return (int)cand.size() >= k - 1 ? countIn(outOf, cand, k - 1, scratch, never) : 0;
+}
+
+typedef unsigned long long Word;
+
+// Word operations of the portable bitset kernel (64-bit AND and popcount)
+struct PortableWords
+{
+    // dst = a & b; returns the number of set bits in dst
+    static inline long long andInto(Word* dst, const Word* a, const Word* b, int words)
+    {
+        long long bits = 0;
+        for (int i = 0; i < words; ++i)
+        {
+            dst[i] = a[i] & b[i];
+            bits += __builtin_popcountll(dst[i]);
+        }
+        return bits;
+    }
+
+    // popcount(a & b)
+    static inline long long andCount(const Word* a, const Word* b, int words)
+    {
+        long long bits = 0;
+        for (int i = 0; i < words; ++i)
+        {
+            bits += __builtin_popcountll(a[i] & b[i]);
+        }
+        return bits;
+    }
+};
+
+#ifdef CLIQUES_HAVE_AVX2_PATH
+/*
+AVX2 versions: four words per 256-bit AND. Popcount of a vector uses Mula's nibble table
+(vpshufb looks up the bit count of every 4-bit half, vpsadbw sums the bytes per 64-bit lane),
+since AVX2 has no vector popcount. The tail words, and all of a row of up to 64 vertices,
+use the scalar POPCNT instruction.
+*/
+struct Avx2Words
+{
+    static inline __attribute__((target("avx2,popcnt"))) __m256i popcount256(__m256i v)
+    {
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0f);
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+    }
+
+    static inline __attribute__((target("avx2,popcnt"))) long long lanes(__m256i acc)
+    {
+        return _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) + _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    }
+
+    static inline __attribute__((target("avx2,popcnt"))) long long andInto(Word* dst, const Word* a, const Word* b, int words)
+    {
+        int i = 0;
+        long long bits = 0;
+        if (words >= 4)
+        {
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 4 <= words; i += 4)
+            {
+                __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+                _mm256_storeu_si256((__m256i*)(dst + i), v);
+                acc = _mm256_add_epi64(acc, popcount256(v));
+            }
+            bits = lanes(acc);
+        }
+        for (; i < words; ++i)
+        {
+            dst[i] = a[i] & b[i];
+            bits += __builtin_popcountll(dst[i]);
+        }
+        return bits;
+    }
+
+    static inline __attribute__((target("avx2,popcnt"))) long long andCount(const Word* a, const Word* b, int words)
+    {
+        int i = 0;
+        long long bits = 0;
+        if (words >= 4)
+        {
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 4 <= words; i += 4)
+            {
+                __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+                acc = _mm256_add_epi64(acc, popcount256(v));
+            }
+            bits = lanes(acc);
+        }
+        for (; i < words; ++i)
+        {
+            bits += __builtin_popcountll(a[i] & b[i]);
+        }
+        return bits;
+    }
+};
+#endif
+
+/*
+Cliques of 'need' more vertices inside the candidate bitset 'cand' of one root.
+rows[i * words ..] holds the out-neighbours of local vertex i inside out(root), so, as in the
+list kernel, AND-ing with row i keeps only vertices ranked above i and every clique is reached once.
+levels[need * words ..] receives the candidate set of the next level.
+*/
+typedef long long (*BitsetLevelFn)(const Word*, int, const Word*, int, Word*);
+
+static long long countBitsPortable(const Word* rows, int words, const Word* cand, int need, Word* levels)
+{
+    long long total = 0;
+    Word* next = levels + (size_t)need * words;
+    for (int w = 0; w < words; ++w)
+    {
+        for (Word bits = cand[w]; bits; bits &= bits - 1)
+        {
+            const Word* row = rows + (size_t)(w * 64 + __builtin_ctzll(bits)) * words;
+            if (need == 2)
+            {
+                total += PortableWords::andCount(cand, row, words); // last level: count, do not visit
+            }
+            else if (PortableWords::andInto(next, cand, row, words) >= need - 1)
+            {
+                total += countBitsPortable(rows, words, next, need - 1, levels);
+            }
+        }
+    }
+    return total;
+}
+
+#ifdef CLIQUES_HAVE_AVX2_PATH
+// The same recursion compiled for AVX2 + POPCNT (GCC only inlines helpers built for the same target)
+__attribute__((target("avx2,popcnt")))
+static long long countBitsAvx2(const Word* rows, int words, const Word* cand, int need, Word* levels)
+{
+    long long total = 0;
+    Word* next = levels + (size_t)need * words;
+    for (int w = 0; w < words; ++w)
+    {
+        for (Word bits = cand[w]; bits; bits &= bits - 1)
+        {
+            const Word* row = rows + (size_t)(w * 64 + __builtin_ctzll(bits)) * words;
+            if (need == 2)
+            {
+                total += Avx2Words::andCount(cand, row, words);
+            }
+            else if (Avx2Words::andInto(next, cand, row, words) >= need - 1)
+            {
+                total += countBitsAvx2(rows, words, next, need - 1, levels);
+            }
+        }
+    }
+    return total;
+}
+#endif
+
+// Picks the AVX2 copy once, if the CPU supports it
+static BitsetLevelFn bitsetKernel()
+{
+#ifdef CLIQUES_HAVE_AVX2_PATH
+    static const BitsetLevelFn fn = (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) ? countBitsAvx2 : countBitsPortable;
+    return fn;
+#else
+    return countBitsPortable;
+#endif
+}
+
+/*
+Builds the bit rows of root u: local ids 0..m-1 follow out(u), and row i has bit j set when
+out(u)[j] is in out(out(u)[i]). Cost: one pass over the out-lists of u's out-neighbours.
+*/
+long long FindingNumCliques::countFromRootBitset(const CliqueDag& dag, int u, int k, BitsetScratch& scratch)
+{
+    if (k == 1)
+    {
+        return 1;
+    }
+    const int m = dag.offsets[u + 1] - dag.offsets[u];
+    if (m < k - 1)
+    {
+        return 0;
+    }
+    if (k == 2)
+    {
+        return m;
+    }
+    const int* out = dag.targets.data() + dag.offsets[u];
+    const int words = (m + 63) / 64;
+    if ((int)scratch.localId.size() < dag.n)
+    {
+        scratch.localId.assign(dag.n, -1);
+    }
+    scratch.rows.assign((size_t)m * words, 0);
+    scratch.levels.assign((size_t)(k + 1) * words, 0);
+    for (int i = 0; i < m; ++i)
+    {
+        scratch.localId[out[i]] = i;
+    }
+    for (int i = 0; i < m; ++i)
+    {
+        Word* row = scratch.rows.data() + (size_t)i * words;
+        int v = out[i];
+        for (int a = dag.offsets[v]; a < dag.offsets[v + 1]; ++a)
+        {
+            int j = scratch.localId[dag.targets[a]];
+            if (j >= 0)
+            {
+                row[j >> 6] |= 1ULL << (j & 63);
+            }
+        }
+    }
+    for (int i = 0; i < m; ++i)
+    {
+        scratch.localId[out[i]] = -1;
+    }
+
+    // Root candidates: all of out(u)
+    Word* cand = scratch.levels.data() + (size_t)k * words;
+    for (int i = 0; i < m; ++i)
+    {
+        cand[i >> 6] |= 1ULL << (i & 63);
+    }
+    return bitsetKernel()(scratch.rows.data(), words, cand, k - 1, scratch.levels.data());
+}
+
+/*
+Decided by the density of the oriented neighbourhoods rather than of the whole graph: the bitset
+kernel was faster on every graph measured (from 0.00002 to 0.5 edge density, 1.3x to 30x), but
+its largest bit matrix takes degeneracy^2 / 8 bytes. It is used whenever that fits the budget.
+*/
+CliqueKernel FindingNumCliques::chooseKernel(const CliqueDag& dag)
+{
+    double words = (dag.degeneracy + 63) / 64;
+    double bytes = (double)dag.degeneracy * words * sizeof(Word);
+    return bytes <= CLIQUES_BITSET_MAX_BYTES ? CLIQUES_BITSET : CLIQUES_LISTS;
+}
+
+/*
+Work-stealing queue of root positions. Worker w owns a range [begin, end) of positions, packed
+into one 64-bit atomic so that the owner and a thief never both get the same position:
+* the owner takes positions from the front, one at a time (a compare-and-swap of begin + 1);
+* a worker whose range is empty scans the others and moves the back half of a victim's range
+  into its own slot (a compare-and-swap of the victim's end).
+Each position is handed out once and a slot never goes back to a value it held earlier, so a
+compare-and-swap made from a stale read just fails and retries. Work is never added, so a worker
+stops after one scan that found nothing; a range that was in flight during that scan is finished
+by whoever took it.
+*/
+class RootStealQueue
+{
+public:
+    // Splits positions 0..total-1 into 'workers' consecutive ranges
+    RootStealQueue(int total, int workers) : slots(workers)
+    {
+        for (int w = 0; w < workers; ++w)
+        {
+            slots[w].range.store(pack((long long)total * w / workers, (long long)total * (w + 1) / workers));
+        }
+    }
+
+    // Next position for worker 'self'; false once no range has anything left
+    bool next(int self, int& position)
+    {
+        std::atomic<unsigned long long>& own = slots[self].range;
+        unsigned long long r = own.load();
+        while (begin(r) < end(r))
+        {
+            if (own.compare_exchange_weak(r, pack(begin(r) + 1, end(r))))
+            {
+                position = begin(r);
+                return true;
+            }
+        }
+        const int workers = (int)slots.size();
+        for (int step = 1; step < workers; ++step)
+        {
+            std::atomic<unsigned long long>& victim = slots[(self + step) % workers].range;
+            unsigned long long v = victim.load();
+            while (begin(v) < end(v))
+            {
+                int take = (end(v) - begin(v) + 1) / 2;
+                int cut = end(v) - take;
+                if (victim.compare_exchange_weak(v, pack(begin(v), cut)))
+                {
+                    own.store(pack(cut + 1, end(v))); // keep the rest of the stolen half
+                    position = cut;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    static unsigned long long pack(long long b, long long e) { return ((unsigned long long)b << 32) | (unsigned long long)e; }
+    static int begin(unsigned long long r) { return (int)(r >> 32); }
+    static int end(unsigned long long r) { return (int)(r & 0xffffffffULL); }
+
+    struct alignas(64) Slot // one cache line each, so owners do not slow each other down
+    {
+        std::atomic<unsigned long long> range{0};
+    };
+    std::vector<Slot> slots;
+};
+
+/*
+Runs countRoot(u, scratch) over the roots that can start a k-clique (out-degree >= k-1) and
+returns the sum. Scratch is one per thread.
+For the parallel run the roots are dealt out by decreasing out-degree, round robin, so every
+worker's range starts with its share of the expensive roots; stealing evens out the rest.
+*/
+template <typename Scratch, typename CountRoot>
+static long long countOverRoots(const CliqueDag& dag, int k, int threads, CountRoot countRoot)
+{
+    std::vector<int> roots;
+    for (int u = 0; u < dag.n; ++u)
+    {
+        if (dag.offsets[u + 1] - dag.offsets[u] >= k - 1)
+        {
+            roots.push_back(u);
+        }
+    }
+    threads = threads > 1 ? teamSize(threads) : 1; // never more threads than cores (THREADS comes from the client)
+    threads = (int)std::min<long long>(threads, (long long)roots.size());
+    if (threads <= 1)
+    {
+        Scratch scratch;
+        long long total = 0;
+        for (int u : roots)
+        {
+            total += countRoot(u, scratch);
+        }
+        return total;
+    }
+
+    // Bucket the roots by out-degree (at most the degeneracy), most expensive first
+    std::vector<int> start(dag.degeneracy + 2, 0);
+    for (int u : roots)
+    {
+        ++start[dag.degeneracy - (dag.offsets[u + 1] - dag.offsets[u]) + 1];
+    }
+    for (int d = 0; d <= dag.degeneracy; ++d)
+    {
+        start[d + 1] += start[d];
+    }
+    std::vector<int> byCost(roots.size());
+    for (int u : roots)
+    {
+        byCost[start[dag.degeneracy - (dag.offsets[u + 1] - dag.offsets[u])]++] = u;
+    }
+
+    // Position p of worker w's range holds byCost[w + p * threads]
+    const int total = (int)roots.size();
+    std::vector<int> order(total);
+    for (int w = 0, p = 0; w < threads; ++w)
+    {
+        for (int i = w; i < total; i += threads)
+        {
+            order[p++] = byCost[i];
+        }
+    }
+    RootStealQueue queue(total, threads);
+
+    std::vector<long long> partial(threads, 0);
+    auto worker = [&](int tid)
+    {
+        Scratch scratch;
+        long long sum = 0; // local, so threads do not share a cache line while counting
+        int position;
+        while (queue.next(tid, position))
+        {
+            sum += countRoot(order[position], scratch);
+        }
+        partial[tid] = sum;
+    };
+    runTeam(threads, worker);
+    long long sum = 0;
+    for (long long p : partial)
+    {
+        sum += p;
+    }
+    return sum;
 }
 
 // Count cliques of size k
-int FindingNumCliques::countCliques(const Graph& graph, int k) 
+long long FindingNumCliques::countCliques(const Graph& graph, int k, CliqueKernel kernel, int threads)
 {
-	std::vector<int> current; // creates an empty vector current to hold the current combination of vertices.
-	return countCliquesRecursive(graph, k, 0, current); // Recursively builds all possible groups of k vertices and counts those that form cliques.
-    // The result is the total number of k-cliques in the graph.
+    if (k < 0 || k > graph.get_vertices())
+    {
+        return 0;
+    }
+    if (k == 0)
+    {
+        return 1; // the empty set, as the subset enumeration this replaces counted it
+    }
+    CliqueDag dag = CliqueDag::build(graph);
+    if (k > dag.degeneracy + 1)
+    {
+        return 0; // a k-clique needs a vertex with k-1 higher-ranked neighbours
+    }
+    if (kernel == CLIQUES_AUTO)
+    {
+        kernel = chooseKernel(dag);
+    }
+    if (kernel == CLIQUES_BITSET)
+    {
+        return countOverRoots<BitsetScratch>(dag, k, threads, [&](int u, BitsetScratch& scratch)
+        {
+            return countFromRootBitset(dag, u, k, scratch);
+        });
+    }
+    return countOverRoots<std::vector<std::vector<int>>>(dag, k, threads, [&](int u, std::vector<std::vector<int>>& scratch)
+    {
+        return countFromRoot(dag, u, k, scratch);
+    });
 }
 
+/*
+Edge sampling without replacement over the graph's stored arcs, in place (no DAG, nothing O(E) to
+set up, so even the first samples arrive within a small budget):
+* A clique's lowest edge is its two smallest ids u < v; its other vertices lie in
+  N+(u) ∩ N+(v), where N+(x) is the part of x's sorted row above x. Arc slot i = (u, v) scores the
+  (k-2)-cliques there if v > u and i is the first copy of v in u's row, and 0 otherwise, so the
+  slots sum to the exact count.
+* The slots are drawn by a Fisher-Yates shuffle done lazily (one step per sample, displaced
+  entries kept in a hash map): the first s draws are s distinct uniform slots.
+Running mean and variance use Welford's update. The clock is read after every sample, and the
+count inside a sample is cut off at the deadline too (a slot with a huge common neighbourhood
+could otherwise run far past it); a sample cut off that way is dropped.
+If every sampled slot scored the same value c (zero spread, e.g. no clique found at all) the
+normal interval has zero width, which says nothing about the slots not drawn yet. Then the
+interval falls back to a rule-of-three bound: at most 3/s of the slots score differently (95%),
+each anywhere in [0, C(D-1, k-2)] for the largest degree D. The precision stop uses the same
+interval, so it is never reached on a zero-width interval.
+*/
+CliqueEstimate FindingNumCliques::estimateCliques(const Graph& graph, int k, double eps, int budgetMs, unsigned seed)
+{
+    const auto start = std::chrono::steady_clock::now();
+    CliqueEstimate est;
+    const IntSpan offsets = graph.get_offsets();
+    const IntSpan targets = graph.get_targets();
+    est.edges = targets.size();
+    auto exact = [&est](double value)
+    {
+        est.estimate = est.low = est.high = value;
+        est.sampled = est.edges;
+        return est;
+    };
+    if (k < 0 || k > graph.get_vertices())
+    {
+        return exact(0);
+    }
+    if (k == 0)
+    {
+        return exact(1);
+    }
+    if (k == 1)
+    {
+        return exact(graph.get_vertices());
+    }
+
+    const int* t = targets.data();
+    auto above = [&](int x) // N+(x)
+    {
+        const int* rowEnd = t + offsets[x + 1];
+        return std::make_pair(std::upper_bound(t + offsets[x], rowEnd, x), rowEnd);
+    };
+    std::unordered_map<long long, long long> moved; // position -> slot, where the shuffle changed it
+    auto at = [&moved](long long i)
+    {
+        auto it = moved.find(i);
+        return it == moved.end() ? i : it->second;
+    };
+    std::mt19937_64 rng(seed);
+    std::vector<std::vector<int>> scratch(k + 1);
+    std::vector<int>& cand = scratch[k]; // countIn only uses the levels below k - 1
+
+    const double m = (double)est.edges;
+    const double z = 1.96; // 95% two-sided
+    double perSlot = -1; // C(D-1, k-2), the most any slot can score (found on first use)
+    auto maxPerSlot = [&]()
+    {
+        if (perSlot < 0)
+        {
+            int maxDegree = 0;
+            for (int u = 0; u < graph.get_vertices(); ++u)
+            {
+                maxDegree = std::max(maxDegree, offsets[u + 1] - offsets[u]);
+            }
+            perSlot = 1;
+            for (int i = 1; i <= k - 2; ++i)
+            {
+                perSlot = perSlot * (maxDegree - 1 - (k - 2) + i) / i;
+            }
+            perSlot = std::max(0.0, perSlot);
+        }
+        return perSlot;
+    };
+    double mean = 0, m2 = 0, sum = 0;
+    long long s = 0;
+    // 95% interval for the total after s samples (s < number of slots)
+    auto interval = [&](double& low, double& high)
+    {
+        const double estimate = m * mean;
+        if (s >= 2 && m2 > 0)
+        {
+            const double half = z * m * std::sqrt(m2 / (s - 1) / s * (1 - s / m));
+            low = std::max(0.0, estimate - half);
+            high = estimate + half;
+            return;
+        }
+        // Zero spread: the slots left are all worth mean too, except (95%) at most 3/s of them
+        const double differ = s > 0 ? std::min(m - s, std::ceil(3.0 * m / s)) : m - s;
+        low = std::max(0.0, estimate - differ * mean);
+        high = estimate + differ * std::max(0.0, maxPerSlot() - mean);
+    };
+    DeadlineStop stop;
+    stop.deadline = start + std::chrono::milliseconds(budgetMs);
+    while (s < est.edges)
+    {
+        if (std::chrono::steady_clock::now() >= stop.deadline)
+        {
+            break;
+        }
+        std::uniform_int_distribution<long long> next(s, est.edges - 1);
+        const long long j = next(rng);
+        const int a = (int)at(j);
+        const int u = (int)(std::upper_bound(offsets.begin(), offsets.end(), a) - offsets.begin()) - 1;
+        const int v = t[a];
+
+        double c = 0;
+        if (v > u && (a == offsets[u] || t[a - 1] != v))
+        {
+            if (k == 2)
+            {
+                c = 1;
+            }
+            else
+            {
+                std::pair<const int*, const int*> nu = above(u), nv = above(v);
+                cand.clear();
+                std::set_intersection(nu.first, nu.second, nv.first, nv.second, std::back_inserter(cand));
+                cand.erase(std::unique(cand.begin(), cand.end()), cand.end()); // parallel arcs
+                c = (int)cand.size() >= k - 2 ? (double)countIn(above, cand, k - 2, scratch, stop) : 0;
+                if (stop.expired)
+                {
+                    break; // partial count: the slot stays undrawn
+                }
+            }
+        }
+        moved[j] = at(s);
+
+        ++s;
+        sum += c;
+        double delta = c - mean;
+        mean += delta / s;
+        m2 += delta * (c - mean);
+        // Stop on precision only once something was found: an all-zero sample says nothing relative
+        if (s < est.edges && s >= std::min<long long>(CLIQUES_APPROX_MIN_SAMPLES, est.edges) && mean > 0)
+        {
+            double low, high;
+            interval(low, high);
+            if (high - low <= 2 * eps * m * mean)
+            {
+                break;
+            }
+        }
+    }
+    est.sampled = s;
+    if (s == est.edges)
+    {
+        return exact(sum); // every slot counted
+    }
+    est.estimate = m * mean;
+    interval(est.low, est.high);
+    return est;
+}
@@ -4,8 +4,39 @@
 
 @date: 14-10-2025
 
-@description: This file contains the declaration of the FindingNumCliques class, which provides 
+@description: This file contains the declaration of the FindingNumCliques class, which provides
 a method to count the number of cliques of a given size in a graph.
+
+Counting follows kClist (Danisch et al.), a refinement of Chiba-Nishizeki:
+* Vertices are ranked by a degeneracy ordering (repeatedly remove a vertex of minimum degree),
+  and every edge is oriented from the lower to the higher rank. The result is a DAG whose
+  out-degrees are at most the degeneracy d of the graph, which is small for real sparse graphs.
+* Each k-clique has exactly one lowest-ranked vertex, so it is counted once: from every root u,
+  recurse into out(u), then into out(u) ∩ out(v) for each v in it, and so on down to size k.
+Cost is O(k * E * (d/2)^(k-2)) instead of checking all C(V,k) vertex subsets.
+
+Two kernels run that recursion:
+* Lists: candidate sets are id-sorted vectors, intersected by merging. Best on sparse graphs.
+* Bitset: for each root u, out(u) is renumbered 0..m-1 and every member's out-neighbourhood
+  inside it becomes a packed row of m bits. Intersections are word-wise AND, and the last level
+  only counts bits (popcount) instead of visiting them. On x86 the kernel is compiled a second
+  time for AVX2 + POPCNT (256-bit AND, nibble-table popcount) and picked at run time when the CPU
+  has them; elsewhere it uses portable 64-bit words.
+CLIQUES_AUTO uses the bitset kernel unless the densest oriented neighbourhood is too large for
+its bit matrix (degeneracy^2 bits) to fit in memory comfortably.
+
+The roots are independent subproblems, so with threads > 1 they are shared out by a
+work-stealing scheduler: every thread owns a slice of the roots and, once it runs dry, steals
+half of what another thread has left. Each thread sums into its own counter with its own
+scratch memory; the counters are added up at the end.
+
+estimateCliques trades exactness for a time limit. Every k-clique has exactly one lowest edge
+(its two smallest ids u < v), so the count is a sum over edges of the (k-2)-cliques above both
+ends. A sample of edges is counted exactly, and (number of edges) * (sample mean) estimates the
+total, with a normal-approximation 95% confidence interval (finite-population corrected, so it
+shrinks to the exact answer once every edge has been drawn). When every sampled edge gave the
+same count that interval has zero width, so a rule-of-three bound replaces it. Sampling reads the
+graph's CSR directly, so unlike the exact count it needs no O(E) preparation before the first sample.
 */
 
 #pragma once
@@ -15,9 +46,68 @@ a method to count the number of cliques of a given size in a graph.
 #include <vector>
 #include <algorithm>
 
-class FindingNumCliques 
+/*
+Degeneracy-oriented form of a graph, as used by the clique algorithms.
+Vertices u < v are adjacent iff is_edge(u, v) holds in the source graph (for an undirected
+graph that is plain adjacency; for a directed one, the arc must go from the smaller id).
+*/
+struct CliqueDag
+{
+    int n = 0;
+    int degeneracy = 0;              // largest out-degree
+    std::vector<int> rank;           // position of each vertex in the degeneracy order
+    std::vector<int> offsets;        // n+1 entries; out(u) = targets[offsets[u] .. offsets[u+1])
+    std::vector<int> targets;        // out-neighbours (higher rank), sorted by vertex id
+
+    // Orients 'graph' by degeneracy order in O(V + E)
+    static CliqueDag build(const Graph& graph);
+};
+
+// Clique kernel selector (also accepted as "PARAM KERNEL <n>" by CliquesAlgo)
+enum CliqueKernel
+{
+    CLIQUES_AUTO = 0,
+    CLIQUES_LISTS = 1,
+    CLIQUES_BITSET = 2
+};
+
+// Result of an approximate count
+struct CliqueEstimate
+{
+    double estimate = 0;       // estimated number of k-cliques
+    double low = 0, high = 0;  // 95% confidence interval
+    long long sampled = 0;     // arcs counted
+    long long edges = 0;       // arcs stored in the graph (sampled == edges means the count is exact)
+};
+
+class FindingNumCliques
 {
 public:
-    // Counts the number of cliques of size k in the given graph
-    int countCliques(const Graph& graph, int k);
-};
\ No newline at end of file
+    // Counts the number of cliques of size k in the given graph (k = 0 counts the empty clique once)
+    // threads > 1 counts the roots on that many threads, at most one per core (the count does not depend on it)
+    long long countCliques(const Graph& graph, int k, CliqueKernel kernel = CLIQUES_AUTO, int threads = 1);
+
+    /*
+    Estimates the number of k-cliques by edge sampling. Stops as soon as the interval's half-width
+    is at most eps * estimate (after a minimum of samples), once budgetMs milliseconds have passed
+    since the call (also checked inside a sample), or when every edge has been counted. k <= 2 and impossible k are answered exactly.
+    */
+    CliqueEstimate estimateCliques(const Graph& graph, int k, double eps, int budgetMs, unsigned seed = 1);
+
+    // The kernel CLIQUES_AUTO resolves to for an oriented graph
+    static CliqueKernel chooseKernel(const CliqueDag& dag);
+
+    // Number of k-cliques whose lowest-ranked vertex is u (the per-root subproblem of countCliques)
+    static long long countFromRoot(const CliqueDag& dag, int u, int k, std::vector<std::vector<int>>& scratch);
+
+    // Per-thread working memory of the bitset kernel (sized on first use)
+    struct BitsetScratch
+    {
+        std::vector<int> localId;         // vertex -> position in out(root), -1 if not in it
+        std::vector<unsigned long long> rows;   // m rows of 'words' words each
+        std::vector<unsigned long long> levels; // one candidate set per recursion level
+    };
+
+    // Same as countFromRoot, with the bitset kernel
+    static long long countFromRootBitset(const CliqueDag& dag, int u, int k, BitsetScratch& scratch);
+};
@@ -1,100 +1,609 @@
 #include "Finding_SCC.hpp"
+#include "Team_Barrier.hpp"
+#include <atomic>
 
+// A coloring round must finish at least 1/SCC_COLOR_MIN_PROGRESS of the vertices left, or the rest is labelled serially
+#define SCC_COLOR_MIN_PROGRESS 8
+// When fewer vertices than this are left, the parallel engine finishes them serially
+#define SCC_SERIAL_TAIL 4096
 
 /*
-This function performs a depth-first search (DFS) starting from vertex v:
-*It marks v as visited.
-*For each neighbor u of v, if u is not visited, it recursively calls itself on u.
-*After visiting all reachable vertices from v, it pushes v onto the stack order.
-
-Purpose:
-It records the finishing order of vertices for Kosaraju's algorithm.
-Vertices are pushed onto the stack after all their descendants are visited,
-so the stack ends up with vertices ordered by their finishing times (used to find SCCs in the transposed graph).
+This function, pearceLabels, is Pearce's single-pass SCC algorithm (PEA_FIND_SCC2) with an
+explicit DFS path instead of recursion:
+1. Entering v gives it the next DFS index in rindex[v] and marks it as a possible root.
+2. Scanning an arc v->w enters w if it is new; otherwise (and after returning from w) v takes
+   rindex[w] if it is smaller, and then v is no longer a root.
+3. Leaving v: a non-root waits on the component stack. A root pops every waiting vertex with
+   rindex >= rindex[v]; they and v form one component.
+Finished vertices get rindex = c, counting down from V-1. Those values are never below a live
+DFS index, so step 2 does not pick them up, and no separate "on stack" flag is needed. The
+component id of v is (V-1) - rindex[v].
+
+Vertices with skip(v) are left out, as if they and their arcs were not in the graph (their
+rindex is left undefined); labelSCCs skips nothing, the parallel engine skips finished vertices.
+completed(v, first, last) is called as each component is popped: v is its root and [first, last)
+its other members, all with rindex set to the component's c. Every arc leaving them ends in a
+component completed earlier, which is what lets condense build the DAG in the same pass.
+
+*Memory is O(V) ints, and the graph's arcs are read in place.
 */
-static void dfsFillOrder(const Graph& graph, int v, std::vector<bool>& visited, std::stack<int>& order) 
+template <class Skip, class Completed>
+static int pearceLabels(const Graph& graph, std::vector<int>& rindex, Skip skip, Completed completed)
 {
-	visited[v] = true;
-	for (int u : graph.get_neighbors(v)) 
+	const int n = graph.get_vertices();
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
+
+	rindex.assign(n, 0);
+	std::vector<char> root(n, 0);
+	std::vector<int> next(n);        // next arc of each vertex on the DFS path
+	std::vector<int> path;           // the DFS path (replaces the recursion)
+	std::vector<int> waiting;        // visited vertices whose component is still open
+	int index = 1;
+	int c = n - 1;
+
+	auto enter = [&](int v)
+	{
+		rindex[v] = index++;
+		root[v] = 1;
+		next[v] = offsets[v];
+		path.push_back(v);
+	};
+
+	for (int s = 0; s < n; ++s) 
     {
-		if (!visited[u]) 
+		if (rindex[s] != 0 || skip(s)) 
         {
-			dfsFillOrder(graph, u, visited, order);
+			continue;
+		}
+		enter(s);
+		while (!path.empty()) 
+        {
+			int v = path.back();
+			if (next[v] < offsets[v + 1]) 
+            {
+				int w = targets[next[v]];
+				if (skip(w))
+				{
+					++next[v];
+					continue;
+				}
+				if (rindex[w] == 0) 
+                {
+					enter(w); // descend; the arc v->w is finished when w is left
+					continue;
+				}
+				if (rindex[w] < rindex[v]) 
+                {
+					rindex[v] = rindex[w];
+					root[v] = 0;
+				}
+				++next[v];
+				continue;
+			}
+
+			// All arcs of v scanned: leave v
+			path.pop_back();
+			if (root[v]) 
+            {
+				--index;
+				size_t first = waiting.size();
+				while (first > 0 && rindex[v] <= rindex[waiting[first - 1]]) 
+                {
+					rindex[waiting[--first]] = c;
+					--index;
+				}
+				rindex[v] = c--;
+				completed(v, waiting.data() + first, waiting.data() + waiting.size());
+				waiting.resize(first);
+			}
+			else 
+            {
+				waiting.push_back(v);
+			}
+
+			// Finish the parent's arc into v
+			if (!path.empty()) 
+            {
+				int u = path.back();
+				if (rindex[v] < rindex[u]) 
+                {
+					rindex[u] = rindex[v];
+					root[u] = 0;
+				}
+				++next[u];
+			}
 		}
 	}
-	order.push(v);
-}
 
-/*
-This function performs a depth-first search (DFS) on the transposed graph starting from vertex v:
-*It marks v as visited.
-*Adds v to the current strongly connected component (component).
-*For each neighbor u of v in the transposed graph, if u is not visited, it recursively calls itself on u.
-
-Purpose:
-It collects all vertices reachable from v in the transposed graph,
-forming one strongly connected component (SCC).
-Each call finds and records a complete SCC.
-*/
-static void dfsOnTranspose(const std::vector<std::vector<int>>& transpose, int v, std::vector<bool>& visited, std::vector<int>& component) \
-{
-	visited[v] = true;
-	component.push_back(v);
-	for (int u : transpose[v]) 
+	for (int v = 0; v < n; ++v) 
     {
-		if (!visited[u]) 
-        {
-			dfsOnTranspose(transpose, u, visited, component);
+		if (!skip(v))
+		{
+			rindex[v] = (n - 1) - rindex[v];
 		}
 	}
+	return (n - 1) - c;
 }
 
 /*
-This function, FindingSCC::findSCCs, implements Kosaraju's algorithm to find all strongly connected components (SCCs) in a directed graph:
-1. Perform a DFS on the original graph to determine the finishing order of vertices (dfsFillOrder).
-2. Create a transposed graph by reversing the direction of all edges.
-3. Perform a DFS on the transposed graph in the order defined by the finishing times to identify SCCs (dfsOnTranspose).
+This function, FindingSCC::labelSCCs, runs pearceLabels on the whole graph, with comp serving as
+rindex (DFS index while searching, component id at the end).
+*/
+int FindingSCC::labelSCCs(const Graph& graph, std::vector<int>& comp)
+{
+	return pearceLabels(graph, comp, [](int) { return false; }, [](int, const int*, const int*) {});
+}
 
-*Each SCC is stored as a vector of vertex indices in the result. The function returns a list of all SCCs found in the graph.
+/*
+This function, FindingSCC::condense, labels the components with pearceLabels and writes the DAG row
+of each component when it is popped. Its arcs then only lead into itself or into components
+with final ids, and rows are completed in id order, so the CSR arrays are appended to directly.
+seen[d] == id marks that d is already in the row of component id, which removes parallel arcs.
 */
-std::vector<std::vector<int>> FindingSCC::findSCCs(const Graph& graph) 
+Condensation FindingSCC::condense(const Graph& graph)
 {
-	int n = graph.get_vertices();
-	std::vector<bool> visited(n, false);
-	std::stack<int> order;
+	const int n = graph.get_vertices();
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
 
-	// 1. Fill vertices in stack according to their finishing times
-	for (int v = 0; v < n; ++v) 
-    {
-		if (!visited[v]) 
-        {
-			dfsFillOrder(graph, v, visited, order);
+	Condensation dag;
+	std::vector<int>& rindex = dag.comp; // holds c = (V-1) - id for finished vertices until the end
+	std::vector<int> seen(n, -1);
+	dag.offsets.assign(1, 0);
+	auto row = [&](int v, const int* first, const int* last)
+	{
+		const int c = rindex[v];
+		const int id = (n - 1) - c;
+		const size_t start = dag.targets.size();
+		auto scan = [&](int u)
+		{
+			for (int a = offsets[u]; a < offsets[u + 1]; ++a)
+			{
+				int w = targets[a];
+				if (rindex[w] != c && seen[(n - 1) - rindex[w]] != id)
+				{
+					seen[(n - 1) - rindex[w]] = id;
+					dag.targets.push_back((n - 1) - rindex[w]);
+				}
+			}
+		};
+		scan(v);
+		for (const int* p = first; p != last; ++p)
+		{
+			scan(*p);
 		}
-	}
+		std::sort(dag.targets.begin() + start, dag.targets.end());
+		dag.offsets.push_back((int)dag.targets.size());
+	};
+	dag.count = pearceLabels(graph, rindex, [](int) { return false; }, row);
+	return dag;
+}
 
-	// 2. Create transpose of the graph
-	std::vector<std::vector<int>> transpose(n);
-	const auto& adj = graph.getAdjList();
-	for (int v = 0; v < n; ++v) 
-    {
-		for (int u : adj[v]) 
-        {
-			transpose[u].push_back(v);
+/*
+This function, FindingSCC::labelSCCsParallel, is the multi-step parallel engine (Slota et al.).
+One team of threads runs every step; steps are separated by barriers:
+1. Reverse CSR: the in-arcs of every vertex (self-loops dropped), filled with atomic cursors.
+   inDeg/outDeg count the arcs between unfinished vertices.
+2. Trim: a vertex with no in-arcs or no out-arcs is a component of its own. Finishing it lowers
+   its neighbours' degrees, which may trim them in the next round.
+3. Forward-backward: from the pivot with the largest inDeg * outDeg (most likely inside the giant
+   component), a parallel BFS marks what it reaches; a backward BFS that stays inside that mark
+   then gives exactly the pivot's component.
+4. Coloring: every unfinished vertex starts with its own id as color, and the largest color is
+   pushed along arcs until nothing changes, so color[v] is the largest vertex that reaches v.
+   A vertex r with color[r] == r reaches all of its color; the ones of that color reaching back
+   to r (a backward search per r, in parallel over the r's) are r's component. Each round
+   finishes at least the component of the largest unfinished vertex.
+5. A small or slowly shrinking remainder goes to pearceLabels, which skips finished vertices.
+While the steps run, comp[v] holds a representative of v's component (a member vertex). The last
+step renumbers the components by their smallest vertex, so the result does not depend on which
+step found a component, nor on the thread count.
+*/
+int FindingSCC::labelSCCsParallel(const Graph& graph, std::vector<int>& comp, int threads)
+{
+	const int n = graph.get_vertices();
+	threads = std::min(threads > 1 ? teamSize(threads) : 1, std::max(n, 1)); // at most one thread per core
+	if (threads <= 1)
+	{
+		int count = labelSCCs(graph, comp);
+		std::vector<int> renumber(count, -1);
+		int next = 0;
+		for (int v = 0; v < n; ++v)
+		{
+			if (renumber[comp[v]] < 0)
+			{
+				renumber[comp[v]] = next++;
+			}
+			comp[v] = renumber[comp[v]];
 		}
+		return count;
 	}
 
-	// 3. Process all vertices in order defined by Stack
-	std::fill(visited.begin(), visited.end(), false);
-	std::vector<std::vector<int>> sccs;
-	while (!order.empty()) 
-    {
-		int v = order.top(); order.pop();
-		if (!visited[v]) 
-        {
-			std::vector<int> component;
-			dfsOnTranspose(transpose, v, visited, component);
-			sccs.push_back(component);
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
+	std::vector<int> rOff(n + 1, 0), rTgt(targets.size());  // reverse CSR
+	std::vector<std::atomic<int>> inDeg(n), outDeg(n);       // arcs between unfinished vertices
+	std::vector<std::atomic<int>> color(n);                  // also the fill cursors of step 1 and the smallest member in the last step
+	std::vector<std::atomic<char>> done(n);                  // v's component is known
+	std::vector<std::atomic<char>> mark(n);                  // BFS marks / "queued" flags of the coloring
+	comp.assign(n, -1);
+
+	std::vector<std::vector<int>> found(threads);            // per thread: vertices found this round
+	std::vector<int> frontier, live;
+	std::vector<long long> partial(threads);                 // per-thread results of a step
+	std::vector<int> pick(threads);
+	int pivot = -1;
+	int count = 0;
+	TeamBarrier barrier(threads);
+
+	auto worker = [&](int tid)
+	{
+		auto slice = [&](size_t total, size_t& lo, size_t& hi)
+		{
+			lo = total * tid / threads;
+			hi = total * (tid + 1) / threads;
+		};
+		size_t lo, hi;
+		slice(n, lo, hi);
+
+		// Rounds shared by the trimming and the BFSs: thread 0 gathers what every thread found, then each expands its part
+		auto rounds = [&](auto&& expand)
+		{
+			while (true)
+			{
+				barrier.wait();
+				if (tid == 0)
+				{
+					frontier.clear();
+					for (const std::vector<int>& f : found)
+					{
+						frontier.insert(frontier.end(), f.begin(), f.end());
+					}
+				}
+				barrier.wait();
+				if (frontier.empty())
+				{
+					return;
+				}
+				found[tid].clear();
+				size_t flo, fhi;
+				slice(frontier.size(), flo, fhi);
+				for (size_t i = flo; i < fhi; ++i)
+				{
+					expand(frontier[i], found[tid]);
+				}
+			}
+		};
+
+		// Gathers the unfinished vertices of 'from' into 'live' (every thread filters its part)
+		auto gatherLive = [&](const std::vector<int>* from)
+		{
+			found[tid].clear();
+			size_t glo, ghi;
+			slice(from ? from->size() : (size_t)n, glo, ghi);
+			for (size_t i = glo; i < ghi; ++i)
+			{
+				int v = from ? (*from)[i] : (int)i;
+				if (!done[v])
+				{
+					found[tid].push_back(v);
+				}
+			}
+			barrier.wait();
+			if (tid == 0)
+			{
+				live.clear();
+				for (std::vector<int>& f : found)
+				{
+					live.insert(live.end(), f.begin(), f.end());
+					f.clear();
+				}
+			}
+			barrier.wait();
+		};
+
+		// 1) Reverse CSR and degrees
+		for (size_t u = lo; u < hi; ++u)
+		{
+			int out = 0;
+			for (int a = offsets[u]; a < offsets[u + 1]; ++a)
+			{
+				if (targets[a] != (int)u)
+				{
+					++out;
+					inDeg[targets[a]].fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+			outDeg[u] = out;
+		}
+		barrier.wait();
+		if (tid == 0)
+		{
+			for (int v = 0; v < n; ++v)
+			{
+				rOff[v + 1] = rOff[v] + inDeg[v];
+				color[v] = rOff[v];
+			}
+		}
+		barrier.wait();
+		for (size_t u = lo; u < hi; ++u)
+		{
+			for (int a = offsets[u]; a < offsets[u + 1]; ++a)
+			{
+				if (targets[a] != (int)u)
+				{
+					rTgt[color[targets[a]].fetch_add(1, std::memory_order_relaxed)] = (int)u;
+				}
+			}
+		}
+
+		// 2) Trim
+		for (size_t v = lo; v < hi; ++v)
+		{
+			if (inDeg[v] == 0 || outDeg[v] == 0)
+			{
+				done[v] = 1;
+				found[tid].push_back((int)v);
+			}
 		}
+		auto finish = [&](std::atomic<int>& degree, int w, std::vector<int>& next)
+		{
+			char no = 0;
+			if (degree.fetch_sub(1) == 1 && done[w].compare_exchange_strong(no, 1))
+			{
+				next.push_back(w);
+			}
+		};
+		rounds([&](int v, std::vector<int>& next)
+		{
+			comp[v] = v;
+			for (int a = offsets[v]; a < offsets[v + 1]; ++a)
+			{
+				if (targets[a] != v)
+				{
+					finish(inDeg[targets[a]], targets[a], next);
+				}
+			}
+			for (int a = rOff[v]; a < rOff[v + 1]; ++a)
+			{
+				finish(outDeg[rTgt[a]], rTgt[a], next);
+			}
+		});
+
+		// 3) Forward-backward search from the pivot
+		long long best = -1;
+		int bestV = -1;
+		for (size_t v = lo; v < hi; ++v)
+		{
+			long long score = (long long)inDeg[v] * outDeg[v];
+			if (!done[v] && score > best)
+			{
+				best = score;
+				bestV = (int)v;
+			}
+		}
+		partial[tid] = best;
+		pick[tid] = bestV;
+		barrier.wait();
+		if (tid == 0)
+		{
+			for (int t = 0; t < threads; ++t)
+			{
+				if (pick[t] >= 0 && (pivot < 0 || partial[t] > best))
+				{
+					best = partial[t]; // lower threads hold lower ids, so ties keep the smaller id
+					pivot = pick[t];
+				}
+			}
+			if (pivot >= 0)
+			{
+				mark[pivot] = 1;
+				found[0].push_back(pivot);
+			}
+		}
+		barrier.wait();
+		if (pivot >= 0)
+		{
+			const int p = pivot;
+			rounds([&](int v, std::vector<int>& next)
+			{
+				for (int a = offsets[v]; a < offsets[v + 1]; ++a)
+				{
+					int w = targets[a];
+					char no = 0;
+					if (!done[w] && mark[w].compare_exchange_strong(no, 1))
+					{
+						next.push_back(w);
+					}
+				}
+			});
+			if (tid == 0)
+			{
+				mark[p] = 2;
+				found[0].push_back(p);
+			}
+			rounds([&](int v, std::vector<int>& next)
+			{
+				comp[v] = p;
+				done[v] = 1;
+				for (int a = rOff[v]; a < rOff[v + 1]; ++a)
+				{
+					int u = rTgt[a];
+					char reached = 1;
+					if (mark[u].compare_exchange_strong(reached, 2))
+					{
+						next.push_back(u);
+					}
+				}
+			});
+		}
+
+		// 4) Coloring rounds
+		gatherLive(nullptr);
+		while (live.size() >= SCC_SERIAL_TAIL)
+		{
+			size_t llo, lhi;
+			slice(live.size(), llo, lhi);
+			for (size_t i = llo; i < lhi; ++i)
+			{
+				color[live[i]] = live[i];
+				mark[live[i]] = 1;
+				found[tid].push_back(live[i]);
+			}
+			rounds([&](int v, std::vector<int>& next)
+			{
+				mark[v] = 0; // before reading the color: a later raise queues v again
+				int c = color[v];
+				for (int a = offsets[v]; a < offsets[v + 1]; ++a)
+				{
+					int w = targets[a];
+					if (done[w])
+					{
+						continue;
+					}
+					int cw = color[w];
+					while (cw < c && !color[w].compare_exchange_weak(cw, c))
+					{
+					}
+					if (cw < c && mark[w].exchange(1) == 0)
+					{
+						next.push_back(w);
+					}
+				}
+			});
+
+			// Roots collect their components; the colors are disjoint, so each search owns its vertices
+			long long finished = 0;
+			std::vector<int> stack;
+			for (size_t i = llo; i < lhi; ++i)
+			{
+				int r = live[i];
+				if (color[r] != r)
+				{
+					continue;
+				}
+				comp[r] = r;
+				done[r] = 1;
+				stack.assign(1, r);
+				while (!stack.empty())
+				{
+					int x = stack.back();
+					stack.pop_back();
+					++finished;
+					for (int a = rOff[x]; a < rOff[x + 1]; ++a)
+					{
+						int u = rTgt[a];
+						if (!done[u] && color[u] == r)
+						{
+							comp[u] = r;
+							done[u] = 1;
+							stack.push_back(u);
+						}
+					}
+				}
+			}
+			partial[tid] = finished;
+			barrier.wait();
+			long long total = 0;
+			for (long long f : partial)
+			{
+				total += f;
+			}
+			bool slow = total * SCC_COLOR_MIN_PROGRESS < (long long)live.size();
+			gatherLive(&live); // filters in place: every thread reads its part before thread 0 rewrites 'live'
+			if (slow)
+			{
+				break; // every thread computed the same 'slow'
+			}
+		}
+
+		// 5) Serial remainder
+		if (tid == 0 && !live.empty())
+		{
+			std::vector<int> tail;
+			int tailCount = pearceLabels(graph, tail, [&](int v) { return done[v] != 0; }, [](int, const int*, const int*) {});
+			std::vector<int> rep(tailCount, -1);
+			for (int v : live)
+			{
+				if (rep[tail[v]] < 0)
+				{
+					rep[tail[v]] = v;
+				}
+				comp[v] = rep[tail[v]];
+			}
+		}
+		barrier.wait();
+
+		// 6) Renumber: color[r] becomes the smallest member of representative r's component, and mark[v] tells if v is one
+		for (size_t v = lo; v < hi; ++v)
+		{
+			color[v] = n;
+		}
+		barrier.wait();
+		for (size_t v = lo; v < hi; ++v)
+		{
+			std::atomic<int>& smallest = color[comp[v]];
+			int cur = smallest;
+			while ((int)v < cur && !smallest.compare_exchange_weak(cur, (int)v))
+			{
+			}
+		}
+		barrier.wait();
+		long long first = 0;
+		for (size_t v = lo; v < hi; ++v)
+		{
+			mark[v] = (color[comp[v]] == (int)v);
+			first += mark[v];
+		}
+		partial[tid] = first;
+		barrier.wait();
+		if (tid == 0)
+		{
+			long long sum = 0;
+			for (long long& p : partial)
+			{
+				long long c = p;
+				p = sum;
+				sum += c;
+			}
+			count = (int)sum;
+		}
+		barrier.wait();
+		int id = (int)partial[tid];
+		for (size_t v = lo; v < hi; ++v)
+		{
+			if (mark[v])
+			{
+				comp[v] = id++;
+			}
+		}
+		barrier.wait();
+		for (size_t v = lo; v < hi; ++v)
+		{
+			if (!mark[v])
+			{
+				comp[v] = comp[color[comp[v]]];
+			}
+		}
+	};
+
+	runTeam(threads, worker);
+	return count;
+}
+
+/*
+This function, FindingSCC::findSCCs, groups the labels of labelSCCs into one vector per component,
+listed source components first (the order Kosaraju's algorithm produced).
+*/
+std::vector<std::vector<int>> FindingSCC::findSCCs(const Graph& graph) 
+{
+	std::vector<int> comp;
+	int count = labelSCCs(graph, comp);
+	std::vector<std::vector<int>> sccs(count);
+	for (int v = 0; v < graph.get_vertices(); ++v) 
+    {
+		sccs[count - 1 - comp[v]].push_back(v);
 	}
 	return sccs;
 }
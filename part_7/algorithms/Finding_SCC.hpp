@@ -4,19 +4,57 @@
 
 @date: 14-10-2025
 
-@description: This file contains the declaration of the FindingSCC class, which implements
-the algorithm to find Strongly Connected Components (SCCs) in a directed graph using Kosaraju's algorithm.
+@description: This file contains the declaration of the FindingSCC class, which finds the
+Strongly Connected Components (SCCs) of a directed graph.
+The engine is Pearce's memory-efficient variant of Tarjan's algorithm, written iteratively:
+* One DFS over the graph's CSR, with no transpose and no recursion, so the depth of the search is
+  limited by memory rather than by the thread stack (a 10M-vertex path is fine).
+* State is a few flat arrays of V ints: rindex (DFS index, later the component id), the next
+  arc to scan per vertex, the DFS path and the stack of vertices waiting for their root.
+  A vertex is a component root iff its rindex never dropped, so no separate lowlink is kept.
+labelSCCsParallel is the multi-threaded engine for large graphs with one giant component: it trims
+trivial components, takes the giant one with a parallel forward-backward BFS and finishes the
+rest by color propagation (see Finding_SCC.cpp).
 */
 #pragma once
 
 #include "../part_1/graph_impl.hpp"
 #include <vector>
-#include <stack>
 #include <algorithm>
 
+// Condensation of a graph: its components and the DAG of the arcs between them, in CSR form
+struct Condensation
+{
+    int count = 0;               // number of components
+    std::vector<int> comp;       // comp[v]: component of vertex v (numbered as by labelSCCs)
+    std::vector<int> offsets;    // count+1 entries; successors of c = targets[offsets[c] .. offsets[c+1])
+    std::vector<int> targets;    // distinct successors of each component, sorted (always lower ids)
+};
+
 class FindingSCC 
 {
 public:
-    // Returns a vector of SCCs, each SCC is a vector of vertex indices
+    /*
+    Stores in comp[v] the component id of every vertex and returns the number of components.
+    Ids follow the order in which components are completed, which is a reverse topological order
+    of the condensation: every arc between components goes from a higher id to a lower one.
+    */
+    int labelSCCs(const Graph& graph, std::vector<int>& comp);
+
+    /*
+    Same components as labelSCCs, found on 'threads' threads, but numbered in the order of their
+    smallest vertex, so the labels depend neither on the engine nor on the thread count.
+    threads is capped at the number of cores; threads <= 1 runs labelSCCs and renumbers its result.
+    */
+    int labelSCCsParallel(const Graph& graph, std::vector<int>& comp, int threads);
+
+    /*
+    Labels the components and builds their condensation DAG in the same DFS, with flat arrays only.
+    Component ids are those of labelSCCs (reverse topological), so processing ids in increasing
+    order always meets the successors of a component before the component itself.
+    */
+    Condensation condense(const Graph& graph);
+
+    // Returns a vector of SCCs, each SCC is a vector of vertex indices (source components first)
     std::vector<std::vector<int>> findSCCs(const Graph& graph);
-};
\ No newline at end of file
+};
@@ -0,0 +1,110 @@
+#include "Gomory_Hu_Tree.hpp"
+
+/*
+Gusfield's algorithm. All vertices start as children of vertex 0. For s = 1 .. V-1:
+1. t = parent[s]; compute a minimum s-t cut (value f, source side S) in the original graph.
+2. Every other vertex that hangs off t and lies on s's side of the cut is moved under s.
+3. If t's own parent is on s's side, s takes t's place in the tree (s goes between t and its
+   parent and the two edge weights are swapped), which keeps the tree a true Gomory-Hu tree.
+The runs depend on each other only through 'parent', so they are sequential; each run can still
+use the parallel push-relabel engine.
+*/
+GomoryHuTree GomoryHuTree::build(const Graph& g, MaxFlowEngine engine, int threads)
+{
+    if (g.is_directed())
+    {
+        throw std::invalid_argument("Gomory-Hu tree needs an undirected graph");
+    }
+    int V = g.get_vertices();
+    GomoryHuTree tree;
+    tree.parent.assign(V, 0);
+    tree.weight.assign(V, 0);
+
+    FindingMaxFlow flow;
+    for (int s = 1; s < V; ++s)
+    {
+        int t = tree.parent[s];
+        MinCut cut = flow.findMinCut(g, s, t, engine, threads);
+        tree.weight[s] = cut.flow;
+        for (int v = 0; v < V; ++v)
+        {
+            if (v != s && cut.sourceSide[v] && tree.parent[v] == t)
+            {
+                tree.parent[v] = s;
+            }
+        }
+        if (cut.sourceSide[tree.parent[t]])
+        {
+            tree.parent[s] = tree.parent[t];
+            tree.parent[t] = s;
+            tree.weight[s] = tree.weight[t];
+            tree.weight[t] = cut.flow;
+        }
+    }
+
+    // Depths, so a query can climb both endpoints to their meeting point
+    tree.depth.assign(V, -1);
+    tree.depth[0] = 0;
+    std::vector<int> path;
+    for (int v = 0; v < V; ++v)
+    {
+        int u = v;
+        while (tree.depth[u] < 0)
+        {
+            path.push_back(u);
+            u = tree.parent[u];
+        }
+        while (!path.empty())
+        {
+            tree.depth[path.back()] = tree.depth[tree.parent[path.back()]] + 1;
+            path.pop_back();
+        }
+    }
+    return tree;
+}
+
+int GomoryHuTree::minCut(int s, int t) const
+{
+    int V = get_vertices();
+    if (s < 0 || s >= V || t < 0 || t >= V)
+    {
+        throw std::out_of_range("source/sink out of range");
+    }
+    int best = INT_MAX;
+    while (s != t)
+    {
+        if (depth[s] < depth[t])
+        {
+            std::swap(s, t);
+        }
+        best = std::min(best, weight[s]);
+        s = parent[s];
+    }
+    return best == INT_MAX ? 0 : best;
+}
+
+// FNV-style mixing of every CSR word, finished with the 64-bit MurmurHash3 finalizer
+unsigned long long GomoryHuTree::fingerprint(const Graph& g)
+{
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    auto add = [&h](unsigned long long x)
+    {
+        h = (h ^ x) * 0x100000001b3ULL;
+    };
+    add((unsigned long long)g.get_vertices());
+    add(g.is_directed() ? 1 : 0);
+    for (IntSpan span : {g.get_offsets(), g.get_targets(), g.get_weights()})
+    {
+        add((unsigned long long)span.size());
+        for (int x : span)
+        {
+            add((unsigned int)x);
+        }
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
@@ -0,0 +1,48 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: Gomory-Hu tree of an undirected capacitated graph.
+The tree has the same vertices as the graph and V-1 weighted edges; for any pair s, t the minimum
+s-t cut value in the graph equals the lightest edge on the tree path between s and t.
+It is built with Gusfield's algorithm: V-1 max-flow runs on the original graph (no contractions),
+each one reusing FindingMaxFlow::findMinCut. Afterwards every min-cut query is a walk along the
+tree, O(V), with no further flow computation.
+*/
+
+#pragma once
+
+#include "../part_1/graph_impl.hpp"
+#include "Finding_Max_Flow.hpp"
+#include <vector>
+
+class GomoryHuTree
+{
+public:
+    /*
+    Builds the tree of g. 'engine' and 'threads' are passed on to every max-flow run
+    (threads > 1 with the push-relabel engine spreads each run over a team of threads).
+    Throws std::invalid_argument if g is directed.
+    */
+    static GomoryHuTree build(const Graph& g, MaxFlowEngine engine = MAXFLOW_AUTO, int threads = 0);
+
+    // Minimum s-t cut value (lightest edge on the tree path). Throws std::out_of_range for a bad vertex.
+    int minCut(int s, int t) const;
+
+    int get_vertices() const { return (int)parent.size(); }
+
+    // Tree edge v - parent(v) and its weight; the root (vertex 0) is its own parent
+    int parent_of(int v) const { return parent[v]; }
+    int weight_to_parent(int v) const { return weight[v]; }
+
+    /*
+    64-bit fingerprint of a graph's vertex count, orientation and CSR arrays.
+    Used as the cache key for trees kept between requests on the same graph.
+    */
+    static unsigned long long fingerprint(const Graph& g);
+
+private:
+    std::vector<int> parent;
+    std::vector<int> weight;
+    std::vector<int> depth; // distance from the root in tree edges
+};
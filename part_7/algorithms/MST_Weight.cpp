@@ -1,23 +1,64 @@
 #include "MST_Weight.hpp"
+#include "Team_Barrier.hpp"
+#include <climits>
+#include <stdexcept>
+#include <atomic>
+
+// Prim is chosen when the average degree is at least this (and the graph is undirected)
+#define MST_PRIM_MIN_AVG_DEGREE 64
 
 /*
-This code defines the Edge struct and its comparison operator:
+This code defines the Edge struct:
 *Edge represents a connection between two vertices (u and v) with a given weight.
-*The operator< allows edges to be compared by their weight, so they can be sorted..
-
-Purpose:
-Sorting edges by weight is essential for Kruskal's algorithm,
-which builds the minimum spanning tree (MST) by repeatedly adding the smallest-weight edge that doesn't form a cycle.
+Kruskal's algorithm builds the minimum spanning tree (MST) by repeatedly adding the smallest-weight
+edge that doesn't form a cycle, so the edges are sorted by weight first (radixSortByWeight).
 */
 struct Edge 
 {
 	int u, v, weight;
-	bool operator<(const Edge& other) const 
-    {
-		return weight < other.weight;
-	}
 };
 
+/*
+This function sorts edges by weight with an LSD radix sort over the 4 bytes of the weight
+(the sign bit is flipped so negative weights come first). All four byte histograms are taken
+in one read, and a byte that is the same for every edge needs no pass. The sort is stable, so
+equal weights keep the order in which the edges were collected.
+*/
+static void radixSortByWeight(std::vector<Edge>& edges)
+{
+	auto key = [](const Edge& e) { return (unsigned)e.weight ^ 0x80000000u; };
+	std::vector<size_t> count(4 * 256, 0);
+	for (const Edge& e : edges)
+	{
+		unsigned k = key(e);
+		for (int d = 0; d < 4; ++d)
+		{
+			++count[d * 256 + ((k >> (8 * d)) & 0xFF)];
+		}
+	}
+	std::vector<Edge> buffer(edges.size());
+	for (int d = 0; d < 4; ++d)
+	{
+		size_t* c = count.data() + d * 256;
+		if (std::find(c, c + 256, edges.size()) != c + 256)
+		{
+			continue; // every edge has the same byte here
+		}
+		size_t sum = 0;
+		for (int b = 0; b < 256; ++b)
+		{
+			size_t n = c[b];
+			c[b] = sum;
+			sum += n;
+		}
+		for (const Edge& e : edges)
+		{
+			buffer[c[(key(e) >> (8 * d)) & 0xFF]++] = e;
+		}
+		edges.swap(buffer);
+	}
+}
+
 /*
 This code defines the Disjoint Set Union (DSU) class, also known as Union-Find:
 *find(x): Finds the representative (root) of the set containing x,
@@ -53,43 +94,457 @@ public:
 	}
 };
 
+/*
+This code defines an indexed binary min-heap of vertices, keyed by key[v]:
+*pos[v] is v's place in the heap (-1 if it is not in it), so a vertex whose key drops is moved
+up in place (decrease-key) instead of being pushed a second time.
+Purpose:
+Prim's algorithm keeps every vertex next to the tree in it, keyed by its cheapest edge into the tree.
+*/
+class IndexedHeap
+{
+	std::vector<int> heap, pos;
+	const std::vector<long long>& key;
+
+	void swapAt(int i, int j)
+	{
+		std::swap(heap[i], heap[j]);
+		pos[heap[i]] = i;
+		pos[heap[j]] = j;
+	}
+	void up(int i)
+	{
+		while (i > 0 && key[heap[(i - 1) / 2]] > key[heap[i]])
+		{
+			swapAt(i, (i - 1) / 2);
+			i = (i - 1) / 2;
+		}
+	}
+	void down(int i)
+	{
+		int n = (int)heap.size();
+		while (true)
+		{
+			int best = i, l = 2 * i + 1, r = 2 * i + 2;
+			if (l < n && key[heap[l]] < key[heap[best]]) best = l;
+			if (r < n && key[heap[r]] < key[heap[best]]) best = r;
+			if (best == i) return;
+			swapAt(i, best);
+			i = best;
+		}
+	}
+public:
+	IndexedHeap(int n, const std::vector<long long>& key) : pos(n, -1), key(key) {}
+
+	bool empty() const { return heap.empty(); }
+
+	// Inserts v, or moves it up after key[v] was lowered
+	void pushOrDecrease(int v)
+	{
+		if (pos[v] < 0)
+		{
+			pos[v] = (int)heap.size();
+			heap.push_back(v);
+		}
+		up(pos[v]);
+	}
+
+	int popMin()
+	{
+		int v = heap[0];
+		swapAt(0, (int)heap.size() - 1);
+		heap.pop_back();
+		pos[v] = -1;
+		if (!heap.empty()) down(0);
+		return v;
+	}
+};
+
 /*
 This function implements Kruskal's algorithm to find the total weight of the Minimum Spanning Tree (MST):
-*It collects all edges from the graph, avoiding duplicates.
-*Sorts the edges by weight (smallest first).
+*It collects all edges from the graph (arcs u->v with u < v, so an undirected edge is taken once).
+*Sorts the edges by weight (smallest first) with the radix sort.
 *Uses the DSU (Union-Find) structure to add edges one by one, only if they connect different components (to avoid cycles).
 *Adds the edge's weight to the total MST weight.
 *Stops when enough edges have been added to connect all vertices (n - 1 edges for n vertices).
-*Returns the total MST weight.
+*Returns the forest: its edges, their total weight and the number of trees (n minus the edges used).
 */
-int MSTWeight::findMSTWeight(const Graph& graph) 
+SpanningForest MSTWeight::kruskal(const Graph& graph) 
 {
 	int n = graph.get_vertices();
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
+	const IntSpan weights = graph.get_weights();
 	std::vector<Edge> edges;
-	const auto& adj = graph.getAdjList();
-	const auto& capacity = graph.get_capacity();
+	edges.reserve(graph.is_directed() ? targets.size() : targets.size() / 2);
 	for (int u = 0; u < n; ++u) 
     {
-		for (int v : adj[u]) 
+		for (int i = offsets[u]; i < offsets[u + 1]; ++i) 
         {
+			int v = targets[i];
 			if (u < v) { // Avoid duplicate edges in undirected graph
-				edges.push_back({u, v, capacity[u][v]});
+				edges.push_back({u, v, weights[i]});
 			}
 		}
 	}
-	std::sort(edges.begin(), edges.end());
+	radixSortByWeight(edges);
 	DSU dsu(n);
-	int mst_weight = 0;
-	int edges_used = 0;
+	SpanningForest forest;
 	for (const auto& e : edges) 
     {	
 		// Try to unite the sets of u and v
 		if (dsu.unite(e.u, e.v)) 
         {
-			mst_weight += e.weight;
-			edges_used++;
-			if (edges_used == n - 1) break;
+			forest.weight += e.weight;
+			forest.edges.push_back({e.u, e.v, e.weight});
+			if ((int)forest.edges.size() == n - 1) break;
+		}
+	}
+	forest.trees = n - (int)forest.edges.size();
+	return forest;
+}
+
+/*
+This function implements Prim's algorithm with the indexed heap:
+*best[v] is the cheapest edge from the tree to v seen so far; the heap holds the vertices next to the tree.
+*Taking the vertex with the cheapest edge adds that edge, then each of its neighbours outside
+the tree may get a cheaper edge (decrease-key).
+*When the heap runs dry, the next vertex not yet reached starts a new tree, so a disconnected
+graph gives the weight of a minimum spanning forest, as Kruskal does.
+*/
+SpanningForest MSTWeight::prim(const Graph& graph)
+{
+	int n = graph.get_vertices();
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
+	const IntSpan weights = graph.get_weights();
+	std::vector<long long> best(n, LLONG_MAX); // above every int weight, so any edge improves it
+	std::vector<int> from(n, -1);  // tree end of best[v]
+	std::vector<char> inTree(n, 0);
+	IndexedHeap heap(n, best);
+	SpanningForest forest;
+	for (int s = 0; s < n; ++s)
+	{
+		if (inTree[s])
+		{
+			continue;
+		}
+		++forest.trees;
+		best[s] = 0; // a new tree: its root comes for free
+		heap.pushOrDecrease(s);
+		while (!heap.empty())
+		{
+			int v = heap.popMin();
+			inTree[v] = 1;
+			if (from[v] >= 0)
+			{
+				forest.weight += best[v];
+				forest.edges.push_back({std::min(v, from[v]), std::max(v, from[v]), (int)best[v]});
+			}
+			for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			{
+				int w = targets[i];
+				if (!inTree[w] && weights[i] < best[w])
+				{
+					best[w] = weights[i];
+					from[w] = v;
+					heap.pushOrDecrease(w);
+				}
+			}
 		}
 	}
-	return mst_weight;
-}
\ No newline at end of file
+	return forest;
+}
+
+/*
+This function implements Boruvka's algorithm on a team of threads; rounds are separated by barriers:
+1. First round, undirected graphs only: every vertex is still its own component and its CSR row
+   holds all of its edges, so it picks its cheapest one alone (ties: smaller neighbour), with no
+   shared list and no atomics. This is the round that sees the most edges.
+2. Every thread collects the edges (arcs u < v, as Kruskal reads them) of its vertex range that
+   still join two components into one shared list of live edges, labeled by the components' roots.
+3. Proposal: each live edge offers itself to both of its components:
+   best[c] is an atomic minimum of (weight, position in the list), one 64-bit key per component.
+   The position makes the order strict, so all picks of a round agree and form no cycle (the
+   order may change between rounds: each round is an MST step on the contracted graph).
+4. Merge: each component's pick is applied with the concurrent union-find. A union that finds
+   both ends already joined (the same edge picked from both sides) adds nothing.
+5. Contraction: the union-find is flattened, every live edge is relabeled to the roots of its
+   ends, and the edges that became internal are dropped. So the proposals of the next round read
+   their components straight from the edge, with no find() per edge.
+The rounds end when no union happens: then every component is a full tree of the forest.
+*/
+SpanningForest MSTWeight::boruvka(const Graph& graph, int threads)
+{
+	const int n = graph.get_vertices();
+	const IntSpan offsets = graph.get_offsets();
+	const IntSpan targets = graph.get_targets();
+	const IntSpan weights = graph.get_weights();
+	threads = std::min(teamSize(threads), std::max(n, 1)); // at most one thread per core
+
+	// An edge between two components: u and v are their roots, from and to its original ends
+	struct LiveEdge
+	{
+		int u, v, weight, from, to;
+	};
+
+	const unsigned long long none = ~0ULL;
+	const auto relaxed = std::memory_order_relaxed;
+	std::vector<std::atomic<int>> parent(n);                     // concurrent union-find
+	std::vector<std::atomic<unsigned long long>> best(n);        // cheapest offer to each component this round
+	std::vector<LiveEdge> live, next;                            // edges still between components
+	std::vector<size_t> start(threads + 1, 0);                   // per-thread offsets into the shared lists
+	std::vector<std::vector<LiveEdge>> kept(threads);
+	std::vector<std::vector<GraphEdge>> picked(threads);
+	std::vector<long long> weight(threads, 0);
+	std::atomic<bool> merged{false};
+	TeamBarrier barrier(threads);
+
+	// Path halving; a root is only ever linked below a smaller root, so the links form no cycle
+	auto find = [&](int x)
+	{
+		while (true)
+		{
+			int p = parent[x].load(relaxed);
+			if (p == x)
+			{
+				return x;
+			}
+			int gp = parent[p].load(relaxed);
+			if (gp != p)
+			{
+				parent[x].compare_exchange_weak(p, gp);
+			}
+			x = gp;
+		}
+	};
+	auto unite = [&](int a, int b)
+	{
+		while (true)
+		{
+			a = find(a);
+			b = find(b);
+			if (a == b)
+			{
+				return false;
+			}
+			if (a < b)
+			{
+				std::swap(a, b);
+			}
+			int root = a;
+			if (parent[a].compare_exchange_strong(root, b))
+			{
+				return true;
+			}
+		}
+	};
+
+	auto worker = [&](int tid)
+	{
+		auto slice = [&](size_t total, size_t& lo, size_t& hi)
+		{
+			lo = total * tid / threads;
+			hi = total * (tid + 1) / threads;
+		};
+		// Turns each thread's count in start[t + 1] into its offset, then sizes 'list' (thread 0)
+		auto prefix = [&](auto& list)
+		{
+			barrier.wait();
+			if (tid == 0)
+			{
+				for (int t = 0; t < threads; ++t)
+				{
+					start[t + 1] += start[t];
+				}
+				list.resize(start[threads]);
+			}
+			barrier.wait();
+		};
+		size_t vlo, vhi;
+		slice(n, vlo, vhi);
+
+		for (size_t u = vlo; u < vhi; ++u)
+		{
+			parent[u].store((int)u, relaxed);
+		}
+		barrier.wait();
+
+		// 1) First round on the CSR (undirected: a row then holds every edge of its vertex)
+		if (!graph.is_directed())
+		{
+			for (size_t u = vlo; u < vhi; ++u)
+			{
+				int to = -1, w = 0;
+				for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+				{
+					int t = targets[i];
+					if (t != (int)u && (to < 0 || weights[i] < w || (weights[i] == w && t < to)))
+					{
+						to = t;
+						w = weights[i];
+					}
+				}
+				if (to >= 0 && unite((int)u, to))
+				{
+					picked[tid].push_back({std::min((int)u, to), std::max((int)u, to), w});
+					weight[tid] += w;
+				}
+			}
+			barrier.wait();
+			for (size_t v = vlo; v < vhi; ++v)
+			{
+				parent[v].store(find((int)v), relaxed);
+			}
+			barrier.wait();
+		}
+
+		// 2) Live edge list, written in vertex order
+		kept[tid].clear();
+		for (size_t u = vlo; u < vhi; ++u)
+		{
+			const int ru = parent[u].load(relaxed);
+			for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+			{
+				const int t = targets[i];
+				if ((int)u < t)
+				{
+					const int rt = parent[t].load(relaxed);
+					if (ru != rt)
+					{
+						kept[tid].push_back({ru, rt, weights[i], (int)u, t});
+					}
+				}
+			}
+		}
+		start[tid + 1] = kept[tid].size();
+		prefix(live);
+		std::copy(kept[tid].begin(), kept[tid].end(), live.begin() + start[tid]);
+
+		while (true)
+		{
+			for (size_t v = vlo; v < vhi; ++v)
+			{
+				best[v].store(none, relaxed);
+			}
+			barrier.wait(); // the live list is complete and every offer is reset
+
+			// 3) Proposal
+			size_t lo, hi;
+			slice(live.size(), lo, hi);
+			for (size_t i = lo; i < hi; ++i)
+			{
+				const LiveEdge& e = live[i];
+				unsigned long long key = ((unsigned long long)((unsigned)e.weight ^ 0x80000000u) << 32) | i;
+				for (int c : {e.u, e.v})
+				{
+					unsigned long long cur = best[c].load(relaxed);
+					while (key < cur && !best[c].compare_exchange_weak(cur, key, relaxed))
+					{
+					}
+				}
+			}
+			barrier.wait();
+
+			// 4) Merge
+			for (size_t v = vlo; v < vhi; ++v)
+			{
+				unsigned long long key = best[v].load(relaxed);
+				if (key == none)
+				{
+					continue;
+				}
+				const LiveEdge& e = live[key & 0xFFFFFFFFULL];
+				if (unite(e.u, e.v))
+				{
+					picked[tid].push_back({e.from, e.to, e.weight});
+					weight[tid] += e.weight;
+					merged = true;
+				}
+			}
+			barrier.wait();
+			if (!merged)
+			{
+				return; // nothing joined two trees: the forest is complete
+			}
+
+			// 5) Contraction: flatten, then relabel and filter the live edges
+			for (size_t v = vlo; v < vhi; ++v)
+			{
+				parent[v].store(find((int)v), relaxed);
+			}
+			barrier.wait();
+			kept[tid].clear();
+			for (size_t i = lo; i < hi; ++i)
+			{
+				LiveEdge e = live[i];
+				e.u = parent[e.u].load(relaxed);
+				e.v = parent[e.v].load(relaxed);
+				if (e.u != e.v)
+				{
+					kept[tid].push_back(e);
+				}
+			}
+			start[tid + 1] = kept[tid].size();
+			prefix(next);
+			if (tid == 0)
+			{
+				merged = false;
+			}
+			std::copy(kept[tid].begin(), kept[tid].end(), next.begin() + start[tid]);
+			barrier.wait();
+			if (tid == 0)
+			{
+				live.swap(next);
+			}
+		}
+	};
+
+	runTeam(threads, worker);
+
+	SpanningForest forest;
+	for (int t = 0; t < threads; ++t)
+	{
+		forest.weight += weight[t];
+		forest.edges.insert(forest.edges.end(), picked[t].begin(), picked[t].end());
+	}
+	forest.trees = n - (int)forest.edges.size();
+	return forest;
+}
+
+/*
+Prim touches every arc once but pays a heap operation per improvement, while Kruskal first copies
+and sorts all edges; on dense graphs (average degree MST_PRIM_MIN_AVG_DEGREE or more) the copy and
+sort cost more than the heap. Directed graphs always go to Kruskal, which reads only arcs u < v.
+*/
+MSTEngine MSTWeight::chooseEngine(const Graph& graph)
+{
+	long long V = graph.get_vertices();
+	return (!graph.is_directed() && (long long)graph.get_arcs() >= V * MST_PRIM_MIN_AVG_DEGREE) ? MST_PRIM : MST_KRUSKAL;
+}
+
+SpanningForest MSTWeight::findSpanningForest(const Graph& graph, MSTEngine engine, int threads)
+{
+	if (engine == MST_AUTO)
+	{
+		engine = chooseEngine(graph);
+	}
+	if (engine == MST_BORUVKA)
+	{
+		return boruvka(graph, threads);
+	}
+	if (engine == MST_PRIM)
+	{
+		if (graph.is_directed())
+		{
+			throw std::invalid_argument("the Prim engine needs an undirected graph");
+		}
+		return prim(graph);
+	}
+	return kruskal(graph);
+}
+
+long long MSTWeight::findMSTWeight(const Graph& graph, MSTEngine engine, int threads)
+{
+	return findSpanningForest(graph, engine, threads).weight;
+}
@@ -5,9 +5,25 @@
 
 @date: 14-10-2025
 
-@description: This file contains the declaration of the MSTWeight class, which implements 
-the algorithm to find the total weight of the Minimum Spanning Tree (MST) using Kruskal's algorithm.
-Using also the DSU (Disjoint Set Union) data structure to efficiently manage and merge sets of vertices.
+@description: This file contains the declaration of the MSTWeight class, which finds the total
+weight of a Minimum Spanning Tree (MST), or of a minimum spanning forest when the graph is not
+connected. The graph is read as undirected: every stored arc u->v with u < v is one edge.
+Three engines:
+* Kruskal: the edges are sorted by weight with an LSD radix sort (byte digits; a digit that is the
+  same for every edge is skipped, so small weights take one or two passes), then added in that
+  order unless the DSU (Disjoint Set Union) already connects their ends. O(E * alpha(V)) after
+  the linear sort. Best on sparse graphs.
+* Prim: grows the tree from one vertex, keeping every outside vertex in an indexed binary heap
+  keyed by its cheapest edge into the tree (decrease-key instead of duplicate entries). It reads
+  the graph's CSR rows in place and copies no edge list, which pays off on dense graphs.
+* Parallel Boruvka: in rounds, every component picks its cheapest outgoing edge (all edges are
+  scanned in parallel, each proposing itself to both of its ends' components with an atomic
+  minimum), the picked edges are merged with a lock-free union-find, and the edges that became
+  internal are dropped. Each round at least halves the number of components, so there are at
+  most log2(V) rounds. Ties are broken by edge position, so the picks never close a cycle.
+  It does more memory traffic than Kruskal per edge and only pays off with several threads.
+MST_AUTO picks Prim for dense undirected graphs and Kruskal otherwise. Totals are 64-bit.
+Every engine returns a minimum spanning forest: one tree per connected component.
 */
 
 
@@ -19,9 +35,40 @@ Using also the DSU (Disjoint Set Union) data structure to efficiently manage and
 #include <vector>
 #include <algorithm>
 
+// MST engine selector (also accepted as "PARAM MST_ENGINE <n>" by MSTAlgo)
+enum MSTEngine
+{
+    MST_AUTO = 0,
+    MST_KRUSKAL = 1,
+    MST_PRIM = 2,
+    MST_BORUVKA = 3
+};
+
+// A minimum spanning forest (a spanning tree when trees == 1)
+struct SpanningForest
+{
+    long long weight = 0;           // total weight of the edges
+    int trees = 0;                  // number of trees = connected components of the graph
+    std::vector<GraphEdge> edges;   // V - trees edges, u < v
+};
+
 class MSTWeight 
 {
 public:
-    // Returns the total weight of the MST
-    int findMSTWeight(const Graph& graph);
+    /*
+    Finds a minimum spanning forest. Throws std::invalid_argument for MST_PRIM on a directed graph.
+    'threads' is only used by MST_BORUVKA (0 = hardware concurrency; capped at it).
+    */
+    SpanningForest findSpanningForest(const Graph& graph, MSTEngine engine = MST_AUTO, int threads = 0);
+
+    // Returns the total weight of the MST (of the minimum spanning forest if the graph is not connected)
+    long long findMSTWeight(const Graph& graph, MSTEngine engine = MST_AUTO, int threads = 0);
+
+    // The engine MST_AUTO resolves to for a graph
+    static MSTEngine chooseEngine(const Graph& graph);
+
+private:
+    SpanningForest kruskal(const Graph& graph);
+    SpanningForest prim(const Graph& graph);
+    SpanningForest boruvka(const Graph& graph, int threads);
 };
@@ -0,0 +1,305 @@
+#include "Max_Flow_Session.hpp"
+#include <climits>
+
+MaxFlowSession::MaxFlowSession(const Graph& g, int source, int sink)
+    : V(g.get_vertices()), directed(g.is_directed()), source(source), sink(sink),
+      adj(g.get_vertices()), forward(g.get_vertices()), level(g.get_vertices()), it(g.get_vertices()), queue(g.get_vertices())
+{
+    if (source < 0 || source >= V || sink < 0 || sink >= V)
+    {
+        throw std::out_of_range("source/sink out of range");
+    }
+
+    // Size everything up front: each vertex gets its out- plus in-degree of arc ids
+    const IntSpan targets = g.get_targets();
+    head.reserve(2 * (size_t)targets.size());
+    cap.reserve(2 * (size_t)targets.size());
+    residual.reserve(2 * (size_t)targets.size());
+    std::vector<int> inDegree(V, 0);
+    for (int v : targets)
+    {
+        ++inDegree[v];
+    }
+    for (int u = 0; u < V; ++u)
+    {
+        adj[u].reserve(g.degree(u) + inDegree[u]);
+    }
+
+    /*
+    Every stored arc of g becomes one forward arc (an undirected edge is already stored both ways).
+    Rows are sorted by target, so parallel arcs are neighbours and forward[u] comes out sorted.
+    Self-loops carry no flow and get no arc; a parallel copy is merged only into an arc its row
+    actually created (an earlier copy of capacity 0 creates none).
+    */
+    for (int u = 0; u < V; ++u)
+    {
+        const IntSpan nbrs = g.get_neighbors(u);
+        const IntSpan caps = g.get_neighbor_weights(u);
+        for (int i = 0; i < nbrs.size(); ++i)
+        {
+            if (nbrs[i] == u)
+            {
+                continue;
+            }
+            if (!forward[u].empty() && forward[u].back().first == nbrs[i])
+            {
+                int a = forward[u].back().second;
+                cap[a] += caps[i];
+                residual[a] += caps[i];
+                continue;
+            }
+            setArc(u, nbrs[i], caps[i]);
+        }
+    }
+    solve();
+}
+
+int MaxFlowSession::findArc(int u, int v) const
+{
+    auto pos = std::lower_bound(forward[u].begin(), forward[u].end(), std::make_pair(v, -1));
+    return (pos != forward[u].end() && pos->first == v) ? pos->second : -1;
+}
+
+void MaxFlowSession::setCapacity(int u, int v, int c)
+{
+    if (u < 0 || u >= V || v < 0 || v >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (c < 0)
+    {
+        throw std::invalid_argument("capacity must not be negative");
+    }
+    setArc(u, v, c);
+    if (!directed)
+    {
+        setArc(v, u, c);
+    }
+}
+
+/*
+Changes one arc's capacity. If the arc carries more flow than the new capacity allows, the
+surplus f is taken off the arc, leaving u with f units too many and v with f too few. Then:
+1. reroute: send as much as possible from u to v around the arc (the value is unchanged);
+2. u's surplus goes back to the source (or on to the sink), and v's deficit is refilled from the
+   source if the residual network still allows it, otherwise it is cancelled back from the sink.
+   Both always succeed: the imbalance sits on flow paths whose reverse arcs are residual arcs,
+   and once one end has been tried to the full, the remaining paths must lead to the other end.
+The source and the sink do not need conservation, so a surplus/deficit there is left alone.
+*/
+void MaxFlowSession::setArc(int u, int v, int c)
+{
+    int a = findArc(u, v);
+    if (a < 0)
+    {
+        if (c == 0 || u == v)
+        {
+            return;
+        }
+        a = (int)head.size();
+        head.push_back(v); cap.push_back(c); residual.push_back(c);
+        head.push_back(u); cap.push_back(0); residual.push_back(0);
+        adj[u].push_back(a);
+        adj[v].push_back(a + 1);
+        forward[u].insert(std::upper_bound(forward[u].begin(), forward[u].end(), std::make_pair(v, a)), std::make_pair(v, a));
+        return;
+    }
+
+    long long f = residual[a + 1]; // flow currently on u->v
+    if (c >= f)
+    {
+        residual[a] += (long long)c - cap[a];
+        cap[a] = c;
+        return;
+    }
+    long long surplus = f - c;
+    cap[a] = c;
+    residual[a] = 0;
+    residual[a + 1] = c;
+
+    auto isFree = [&](int x) { return x == source || x == sink; };
+    if (!isFree(u) && !isFree(v))
+    {
+        surplus -= augment(u, v, surplus);
+    }
+    if (!isFree(u))
+    {
+        long long left = surplus - augment(u, source, surplus);
+        augment(u, sink, left);
+    }
+    if (!isFree(v))
+    {
+        long long left = surplus - augment(source, v, surplus);
+        augment(sink, v, left);
+    }
+    value = sinkInflow();
+}
+
+int MaxFlowSession::solve()
+{
+    augment(source, sink, LLONG_MAX);
+    value = sinkInflow();
+    return (int)value;
+}
+
+int MaxFlowSession::update(const Graph& g)
+{
+    if (g.get_vertices() != V || g.is_directed() != directed)
+    {
+        throw std::invalid_argument("graph does not match the max-flow session");
+    }
+
+    /*
+    Merge each row of g (sorted, parallel arcs summed) with the session's sorted row, collecting
+    (u, v, new capacity) for arcs that changed, appeared or disappeared. The edits are applied
+    afterwards, since creating an arc reshapes forward[u].
+    */
+    std::vector<GraphEdge> edits;
+    for (int u = 0; u < V; ++u)
+    {
+        const IntSpan nbrs = g.get_neighbors(u);
+        const IntSpan caps = g.get_neighbor_weights(u);
+        const auto& row = forward[u];
+        int i = 0;
+        size_t j = 0;
+        while (i < nbrs.size() || j < row.size())
+        {
+            if (j == row.size() || (i < nbrs.size() && nbrs[i] < row[j].first))
+            {
+                int v = nbrs[i], c = 0;
+                for (; i < nbrs.size() && nbrs[i] == v; ++i)
+                {
+                    c += caps[i];
+                }
+                edits.push_back({u, v, c}); // new arc
+            }
+            else if (i == nbrs.size() || row[j].first < nbrs[i])
+            {
+                if (cap[row[j].second] != 0)
+                {
+                    edits.push_back({u, row[j].first, 0}); // arc gone from g
+                }
+                ++j;
+            }
+            else
+            {
+                int v = nbrs[i], c = 0;
+                for (; i < nbrs.size() && nbrs[i] == v; ++i)
+                {
+                    c += caps[i];
+                }
+                if (cap[row[j].second] != c)
+                {
+                    edits.push_back({u, v, c});
+                }
+                ++j;
+            }
+        }
+    }
+    for (const GraphEdge& e : edits)
+    {
+        setArc(e.u, e.v, e.w);
+    }
+    return solve();
+}
+
+long long MaxFlowSession::sinkInflow() const
+{
+    long long in = 0;
+    for (int a : adj[sink])
+    {
+        in += residual[a] - cap[a]; // flow coming in along the pair of a, minus flow leaving along a
+    }
+    return in;
+}
+
+/*
+Dinic restricted to 'limit' units: BFS levels from 'from', then an iterative blocking-flow walk
+with current-arc pointers (same scheme as the one-shot engine in Finding_Max_Flow.cpp).
+*/
+long long MaxFlowSession::augment(int from, int to, long long limit)
+{
+    if (from == to || limit <= 0)
+    {
+        return 0;
+    }
+    long long sent = 0;
+    std::vector<int> path;
+    auto bfs = [&]() -> bool
+    {
+        std::fill(level.begin(), level.end(), -1);
+        int qh = 0, qt = 0;
+        queue[qt++] = from;
+        level[from] = 0;
+        while (qh < qt && level[to] < 0)
+        {
+            int x = queue[qh++];
+            for (int a : adj[x])
+            {
+                if (level[head[a]] < 0 && residual[a] > 0)
+                {
+                    level[head[a]] = level[x] + 1;
+                    queue[qt++] = head[a];
+                }
+            }
+        }
+        return level[to] >= 0;
+    };
+
+    while (sent < limit && bfs())
+    {
+        std::fill(it.begin(), it.end(), 0);
+        path.clear();
+        int x = from;
+        while (sent < limit)
+        {
+            if (x == to)
+            {
+                long long pathFlow = limit - sent;
+                for (int a : path)
+                {
+                    pathFlow = std::min(pathFlow, residual[a]);
+                }
+                for (int a : path)
+                {
+                    residual[a] -= pathFlow;
+                    residual[a ^ 1] += pathFlow;
+                }
+                sent += pathFlow;
+
+                // Retreat to the tail of the first saturated arc
+                size_t k = 0;
+                while (k < path.size() && residual[path[k]] > 0)
+                {
+                    ++k;
+                }
+                path.resize(k);
+                x = path.empty() ? from : head[path.back()];
+                continue;
+            }
+
+            int& i = it[x];
+            while (i < (int)adj[x].size() && !(residual[adj[x][i]] > 0 && level[head[adj[x][i]]] == level[x] + 1))
+            {
+                ++i;
+            }
+            if (i < (int)adj[x].size())
+            {
+                path.push_back(adj[x][i]); // advance
+                x = head[adj[x][i]];
+            }
+            else
+            {
+                if (x == from)
+                {
+                    break; // blocking flow reached
+                }
+                level[x] = -1;   // dead end
+                path.pop_back(); // retreat
+                x = path.empty() ? from : head[path.back()];
+                ++it[x];
+            }
+        }
+    }
+    return sent;
+}
@@ -0,0 +1,74 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: Incremental max flow. A MaxFlowSession keeps the residual network of one
+source/sink pair between solves, so a capacity edit only costs the flow it actually changes:
+* An increase (or a new arc) just adds residual capacity; the next solve() augments from the
+  current flow instead of from zero.
+* A decrease below the arc's current flow removes only the surplus: the excess left at the tail
+  is first rerouted to the head through the residual network, and whatever cannot be rerouted is
+  cancelled back along the flow paths (tail -> source and sink -> head), which lowers the value.
+Augmentation is Dinic over per-vertex arc lists, so arcs can be added without a rebuild.
+*/
+
+#pragma once
+
+#include "../part_1/graph_impl.hpp"
+#include <vector>
+#include <utility>
+
+class MaxFlowSession
+{
+public:
+    // Builds the residual network of g (parallel arcs are merged) and solves it. Throws std::out_of_range for a bad source/sink.
+    MaxFlowSession(const Graph& g, int source, int sink);
+
+    // Sets the capacity of u->v (both directions on an undirected graph); 0 removes it. Call solve() afterwards.
+    void setCapacity(int u, int v, int cap);
+
+    // Augments from the current flow to a maximum flow and returns its value
+    int solve();
+
+    /*
+    Applies every capacity of g that differs from the session (arcs missing in g drop to 0), then solves.
+    g must have the session's vertex count and orientation (std::invalid_argument otherwise).
+    */
+    int update(const Graph& g);
+
+    // Value of the current flow (maximum after solve())
+    int flow() const { return (int)value; }
+
+    int get_vertices() const { return V; }
+    bool is_directed() const { return directed; }
+    int get_source() const { return source; }
+    int get_sink() const { return sink; }
+
+private:
+    // Capacity of the single arc u->v, creating the arc pair on first use
+    void setArc(int u, int v, int cap);
+
+    // Forward arc u->v, or -1 if it was never created
+    int findArc(int u, int v) const;
+
+    // Pushes up to 'limit' units from 'from' to 'to' through the residual network (Dinic); returns the amount sent
+    long long augment(int from, int to, long long limit);
+
+    // Net flow into the sink
+    long long sinkInflow() const;
+
+    int V;
+    bool directed;
+    int source, sink;
+    long long value = 0;
+
+    // Arcs come in pairs: 2k is u->v with capacity cap[2k], 2k+1 is its reverse v->u with capacity 0
+    std::vector<std::vector<int>> adj; // arc ids leaving each vertex
+    std::vector<int> head;             // head vertex of each arc
+    std::vector<int> cap;              // own capacity of each arc
+    std::vector<long long> residual;   // remaining capacity of each arc
+    std::vector<std::vector<std::pair<int, int>>> forward; // (v, arc u->v) for each u, sorted by v
+
+    // Dinic scratch space
+    std::vector<int> level, it, queue;
+};
@@ -0,0 +1,191 @@
+#include "SCC_Session.hpp"
+#include "Finding_SCC.hpp"
+#include <stdexcept>
+
+/*
+The initial state comes from FindingSCC::condense: each component's first vertex becomes its root,
+and since condense numbers components in reverse topological order, ord = (count-1) - id is a
+topological order of the DAG. Its rows are already free of parallel arcs.
+*/
+SCCSession::SCCSession(const Graph& g)
+    : V(g.get_vertices()), directed(g.is_directed()), parent(g.get_vertices()), ord(g.get_vertices(), 0),
+      out(g.get_vertices()), in(g.get_vertices()), seenF(g.get_vertices(), 0), seenB(g.get_vertices(), 0)
+{
+    FindingSCC scc;
+    Condensation dag = scc.condense(g);
+    components = dag.count;
+
+    std::vector<int> rootOf(dag.count, -1);
+    for (int v = 0; v < V; ++v)
+    {
+        int c = dag.comp[v];
+        if (rootOf[c] < 0)
+        {
+            rootOf[c] = v;
+            ord[v] = (dag.count - 1) - c;
+        }
+        parent[v] = rootOf[c];
+    }
+    for (int c = 0; c < dag.count; ++c)
+    {
+        for (int i = dag.offsets[c]; i < dag.offsets[c + 1]; ++i)
+        {
+            out[rootOf[c]].push_back(rootOf[dag.targets[i]]);
+            in[rootOf[dag.targets[i]]].push_back(rootOf[c]);
+        }
+    }
+}
+
+int SCCSession::find(int v)
+{
+    int r = v;
+    while (parent[r] != r)
+    {
+        r = parent[r];
+    }
+    while (parent[v] != r) // path compression
+    {
+        int next = parent[v];
+        parent[v] = r;
+        v = next;
+    }
+    return r;
+}
+
+void SCCSession::insertArc(int u, int v)
+{
+    if (u < 0 || u >= V || v < 0 || v >= V)
+    {
+        throw std::out_of_range("vertex out of range");
+    }
+    const int x = find(u), y = find(v);
+    if (x == y)
+    {
+        return; // inside a component
+    }
+    out[x].push_back(y);
+    in[y].push_back(x);
+    if (ord[x] < ord[y])
+    {
+        return; // the order already agrees with the arc
+    }
+
+    // Affected region: the positions from ord[y] to ord[x]
+    const int lo = ord[y], hi = ord[x];
+    ++stamp;
+    auto search = [&](int start, std::vector<std::vector<int>>& arcs, std::vector<unsigned>& seen, std::vector<int>& found)
+    {
+        found.clear();
+        seen[start] = stamp;
+        stack.assign(1, start);
+        while (!stack.empty())
+        {
+            int c = stack.back();
+            stack.pop_back();
+            found.push_back(c);
+            for (int& t : arcs[c])
+            {
+                t = find(t); // keep the entry fresh for the next search
+                if (t != c && seen[t] != stamp && ord[t] >= lo && ord[t] <= hi)
+                {
+                    seen[t] = stamp;
+                    stack.push_back(t);
+                }
+            }
+        }
+    };
+    search(y, out, seenF, forward);
+    search(x, in, seenB, backward);
+    const bool cycle = seenF[x] == stamp;
+
+    // The positions the affected components give back, in increasing order
+    pool.clear();
+    for (int c : backward)
+    {
+        pool.push_back(ord[c]);
+    }
+    for (int c : forward)
+    {
+        if (seenB[c] != stamp)
+        {
+            pool.push_back(ord[c]);
+        }
+    }
+    std::sort(pool.begin(), pool.end());
+    auto byOrd = [&](int a, int b) { return ord[a] < ord[b]; };
+    std::sort(backward.begin(), backward.end(), byOrd);
+    std::sort(forward.begin(), forward.end(), byOrd);
+
+    // With a cycle, the components found by both searches (on a path v ~> u) become one
+    int merged = -1;
+    if (cycle)
+    {
+        for (int c : forward)
+        {
+            if (seenB[c] != stamp)
+            {
+                continue;
+            }
+            if (merged < 0)
+            {
+                merged = c;
+                continue;
+            }
+            --components;
+            int keep = merged, gone = c;
+            if (out[keep].size() + in[keep].size() < out[gone].size() + in[gone].size())
+            {
+                std::swap(keep, gone);
+            }
+            parent[gone] = keep;
+            out[keep].insert(out[keep].end(), out[gone].begin(), out[gone].end());
+            in[keep].insert(in[keep].end(), in[gone].begin(), in[gone].end());
+            std::vector<int>().swap(out[gone]);
+            std::vector<int>().swap(in[gone]);
+            merged = keep;
+        }
+    }
+
+    /*
+    Reassign: backward-only components take the lowest positions and forward-only ones the highest,
+    so the former only move down and the latter only up, which keeps every arc from or to an
+    unaffected component in order. The merged one (if any) goes right after the backward ones.
+    */
+    size_t next = 0;
+    for (int c : backward)
+    {
+        if (seenF[c] != stamp)
+        {
+            ord[c] = pool[next++];
+        }
+    }
+    if (merged >= 0)
+    {
+        ord[merged] = pool[next];
+    }
+    next = pool.size();
+    for (auto c = forward.rbegin(); c != forward.rend(); ++c)
+    {
+        if (seenB[*c] != stamp)
+        {
+            ord[*c] = pool[--next];
+        }
+    }
+}
+
+void SCCSession::insert(const Graph& g)
+{
+    if (g.get_vertices() != V || g.is_directed() != directed)
+    {
+        throw std::invalid_argument("graph does not match the session (V or orientation changed)");
+    }
+    const IntSpan offsets = g.get_offsets();
+    const IntSpan targets = g.get_targets();
+    for (int u = 0; u < V; ++u)
+    {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i)
+        {
+            insertArc(u, targets[i]);
+        }
+    }
+}
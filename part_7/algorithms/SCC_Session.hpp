@@ -0,0 +1,61 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: Incremental strongly connected components. An SCCSession keeps the condensation DAG
+of a graph between requests, so inserting a few arcs does not find every component again:
+* Components are the sets of a union-find over the vertices; the root of a set stands for its
+  component and keeps its DAG arcs and its position ord[] in a topological order of the DAG.
+* An arc u->v that agrees with the order (or stays inside a component) costs O(1) amortized.
+* Otherwise the order is repaired as in Pearce and Kelly's dynamic topological sort: a forward
+  search from v and a backward search from u, both limited to the positions between the two,
+  find the affected components. If the forward search reaches u, the new arc closes a cycle and
+  the components found by both searches are merged into one. The affected components then take
+  back their own positions: those that reach u first, the merged one, then those reached from v.
+The cost of an insertion depends only on the part of the order between its two ends, not on V + E.
+Merging appends the smaller arc lists to the larger; stale entries are mapped through find().
+*/
+
+#pragma once
+
+#include "../part_1/graph_impl.hpp"
+#include <vector>
+
+class SCCSession
+{
+public:
+    // Builds the components of g and their condensation DAG in one DFS (FindingSCC::condense)
+    explicit SCCSession(const Graph& g);
+
+    // Adds the arc u->v, merging the components it closes a cycle through. Throws std::out_of_range for a bad vertex.
+    void insertArc(int u, int v);
+
+    /*
+    Adds every arc of g (an undirected edge is stored both ways, so it joins its two ends).
+    g must have the session's vertex count and orientation (std::invalid_argument otherwise).
+    */
+    void insert(const Graph& g);
+
+    // Number of strongly connected components
+    int count() const { return components; }
+
+    // Representative vertex of v's component: u and v are strongly connected iff find(u) == find(v)
+    int find(int v);
+
+    int get_vertices() const { return V; }
+    bool is_directed() const { return directed; }
+
+private:
+    int V;
+    bool directed;
+    int components = 0;
+
+    std::vector<int> parent;               // union-find over the vertices
+    std::vector<int> ord;                  // position of each root in the topological order (arcs go to higher ord)
+    std::vector<std::vector<int>> out, in; // DAG arcs of each root, stored as vertices (map through find)
+
+    // Search scratch: seenF/seenB[c] == stamp marks c as found by the forward/backward search of this insertion
+    std::vector<unsigned> seenF, seenB;
+    unsigned stamp = 0;
+    std::vector<int> forward, backward, stack, pool;
+};
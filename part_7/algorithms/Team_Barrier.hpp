@@ -0,0 +1,118 @@
+/*
+@author : Roy Meoded
+@author : Yarin Keshet
+
+@description: Reusable barrier for a team of worker threads (C++17 has no std::barrier).
+The parallel engines (push-relabel, SCC) keep one team for the whole run and separate
+their steps with wait() instead of starting new threads for every step.
+runTeam starts such a team safely, and teamSize bounds a requested thread count.
+*/
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+class TeamBarrier
+{
+public:
+    explicit TeamBarrier(int count) : count(count) {}
+
+    // Blocks until all 'count' threads have called wait(); can be reused right away
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mu);
+        unsigned gen = generation;
+        if (++waiting == count)
+        {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else
+        {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+
+private:
+    std::mutex mu;
+    std::condition_variable cv;
+    int count;
+    int waiting = 0;
+    unsigned generation = 0;
+};
+
+/*
+Number of threads to run for a requested count: at most the hardware's, at least 1, and
+requested <= 0 means all of them. THREADS comes from the client, and more threads than cores
+never makes these engines faster, so a larger count is capped instead of started.
+*/
+inline int teamSize(int requested)
+{
+    const int cores = (int)std::max(1u, std::thread::hardware_concurrency());
+    return requested <= 0 ? cores : std::min(requested, cores);
+}
+
+/*
+Runs worker(0) .. worker(count - 1), worker(0) on the calling thread. The other threads are held
+at a start gate until all of them exist: if one cannot be started, the ones already running
+leave without calling worker (so none of them waits on a barrier that can no longer fill up),
+are joined, and std::invalid_argument is thrown instead of std::terminate on their destruction.
+*/
+template <class Worker>
+void runTeam(int count, const Worker& worker)
+{
+    std::mutex mu;
+    std::condition_variable cv;
+    int state = 0; // 0 = starting, 1 = go, -1 = abort
+    auto member = [&](int tid)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mu);
+            cv.wait(lock, [&] { return state != 0; });
+            if (state < 0)
+            {
+                return;
+            }
+        }
+        worker(tid);
+    };
+    auto open = [&](int to)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            state = to;
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> team;
+    try
+    {
+        team.reserve(count > 1 ? count - 1 : 0);
+        for (int t = 1; t < count; ++t)
+        {
+            team.emplace_back(member, t);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        open(-1);
+        for (std::thread& th : team)
+        {
+            th.join();
+        }
+        throw std::invalid_argument("cannot start " + std::to_string(count) + " threads: " + ex.what());
+    }
+    open(1);
+    worker(0);
+    for (std::thread& th : team)
+    {
+        th.join();
+    }
+}
@@ -31,6 +31,40 @@ int main()
 
     std::cout << "Max flow from 0 to 5: " << maxFlow << std::endl;
     std::cout <<"---------------------------------------------------------------------------------------------------"<< std::endl;
+
+    // --- Max Flow engines on a dense, high-capacity network ---
+    std::cout << "--- Max Flow engines on a dense network (timing) ---\n";
+
+    // ~70% of all arcs present, capacities up to 100000 (a deterministic pattern, so every run is the same graph)
+    const int denseV = 200;
+    std::vector<GraphEdge> denseEdges;
+    for (int u = 0; u < denseV; ++u)
+    {
+        for (int v = 0; v < denseV; ++v)
+        {
+            if (u != v && (u * 7 + v * 13) % 10 < 7)
+            {
+                denseEdges.push_back({u, v, (u * 131 + v * 71) % 100000 + 1});
+            }
+        }
+    }
+    Graph g_dense = Graph::from_edge_list(denseV, true, denseEdges);
+    std::cout << "Vertices: " << denseV << ", arcs: " << g_dense.get_arcs() << std::endl;
+
+    const std::pair<MaxFlowEngine, const char*> engines[] =
+    {
+        {MAXFLOW_EDMONDS_KARP, "Edmonds-Karp"},
+        {MAXFLOW_DINIC, "Dinic"},
+        {MAXFLOW_PUSH_RELABEL, "Push-relabel"}
+    };
+    for (const auto& engine : engines)
+    {
+        auto start = std::chrono::steady_clock::now();
+        int flow = algo.findMaxFlow(g_dense, 0, denseV - 1, engine.first);
+        auto ms = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+        std::cout << engine.second << ": max flow " << flow << " in " << ms << " ms" << std::endl;
+    }
+    std::cout <<"---------------------------------------------------------------------------------------------------"<< std::endl;
     std::cout << "***************************************************************************************************" << std::endl;
     
     Graph g_directed_2(7, true);
@@ -96,7 +130,7 @@ int main()
     std::cout << "\n--- Finding Number of Cliques ---\n";
     FindingNumCliques cliqueFinder;
     int k = 3; // Size of cliques to find
-    int numCliques = cliqueFinder.countCliques(g_undirected_1, k);
+    long long numCliques = cliqueFinder.countCliques(g_undirected_1, k);
     std::cout << "k = " << k << std::endl;
     std::cout << "Number of " << k << "-cliques: " << numCliques << std::endl;
     std::cout <<"---------------------------------------------------------------------------------------------------"<< std::endl;
@@ -131,7 +165,7 @@ int main()
     // --- MST Weight ---
     std::cout << "\n--- Finding Minimum Spanning Tree (MST) Weight ---\n";
     MSTWeight mstFinder;
-    int mstWeight = mstFinder.findMSTWeight(g_undirected_2);
+    long long mstWeight = mstFinder.findMSTWeight(g_undirected_2);
     std::cout << "MST weight: " << mstWeight << std::endl;
 
     return 0;
@@ -16,4 +16,5 @@ and calculating the weight of the minimum spanning tree (MST).
 #include "Finding_SCC.hpp"
 #include "MST_Weight.hpp"
 #include <iostream>
+#include <chrono>
 #include "graph_impl.hpp"
@@ -172,12 +172,9 @@ int run_server(int argc, char *argv[])
             int V = -1;
             int directed = 1; // default directed for MAX_FLOW
             int E = 0;
-            struct EdgeLine 
-            {
-                 int u, v, w; 
-            };
-            std::vector<EdgeLine> edges;
+            std::vector<GraphEdge> edges;
             int src = -1, sink = -1; int k = -1;
+            std::unordered_map<std::string,int> extraParams;
 
             bool parse_error = false;
             std::string parse_error_msg;
@@ -285,6 +282,10 @@ int run_server(int argc, char *argv[])
                     {
                         k = val;
                     }
+                    else if (ls)
+                    {
+                        extraParams[key] = val; // any other key (e.g. ENGINE) goes to the algorithm as-is
+                    }
                 }
                 else if (line.empty()) 
                 {
@@ -310,18 +311,14 @@ int run_server(int argc, char *argv[])
                 send_response(fd, "Missing/invalid V", false);
                 continue; 
             }
-            if (alg == "MAX_FLOW" && src >= 0 && sink >= 0 && src == sink) 
+            if ((alg == "MAX_FLOW" || alg == "MAX_FLOW_PR" || alg == "MIN_CUT") && src >= 0 && sink >= 0 && src == sink) 
             {
                 send_response(fd, "SRC and SINK must be different", false);
                 continue;
             }
             try 
             {
-                Graph g(V, directed != 0);
-                for (const auto &e : edges)
-                {
-                    g.addEdge(e.u, e.v, e.w);
-                } 
+                Graph g = Graph::from_edge_list(V, directed != 0, edges);
 
                 auto algoPtr = AlgorithmFactory::create(alg);
                 if (!algoPtr) 
@@ -330,7 +327,7 @@ int run_server(int argc, char *argv[])
                     continue; 
                 }
 
-                std::unordered_map<std::string,int> params;
+                std::unordered_map<std::string,int> params = extraParams;
                 if (src >= 0)
                 {
                     params["SRC"] = src;
@@ -344,8 +341,7 @@ int run_server(int argc, char *argv[])
                    params["K"] = k; 
                 } 
 
-                std::string out = algoPtr->run(g, params); // strategy pattern usage
-                send_response(fd, out, true);
+                send_streamed(fd, *algoPtr, g, params); // strategy pattern usage, answer sent as it is produced
             }
             catch (const std::exception &ex) 
             {
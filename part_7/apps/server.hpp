@@ -9,6 +9,8 @@ functions for handling client requests, processing data, and sending responses.
 Defined functions:
 - recv_all_lines(fd, out): Receives all lines from a client socket.
 - send_response(fd, body, ok): Sends a response back to the client.
+- send_streamed(fd, algo, g, params): Runs an algorithm and sends its answer piece by piece
+  (shared with parts 8-9, see strategy_factory/StreamedResponse.hpp).
 - run_server(argc, argv): Main server function to start the server and accept client connections.
 
 */
@@ -34,6 +36,7 @@ Defined functions:
 #include "Finding_Max_Flow.hpp"
 #include "../part_1/graph_impl.hpp"
 #include "../strategy_factory/AlgorithmFactory.hpp"
+#include "../strategy_factory/StreamedResponse.hpp" // send_streamed
 
 #define PORT 9090 // Default port
 
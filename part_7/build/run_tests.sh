@@ -17,6 +17,24 @@ cleanup() {
 }
 trap cleanup EXIT
 
+# Answers that are checked (not only run for coverage); the script fails at the end if any differ
+FAILS=0
+ask() { # ask <name> <request in printf format>: answer goes to build/<name>.out
+  printf "$2" | nc -N 127.0.0.1 9090 > "build/$1.out" 2> "build/$1.err" || true
+}
+expect_same() { # expect_same <label> <name> <name>: two answers must be identical
+  if ! cmp -s "build/$2.out" "build/$3.out"; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "build/$2.out")' vs '$(tr '\n' ' ' < "build/$3.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+expect_text() { # expect_text <label> <name> <answer in printf format>
+  if [ "$(cat "build/$2.out")" != "$(printf "$3")" ]; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "build/$2.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+
 # ---------- BASIC QUICK EXIT ----------
 echo "[2] Client quick exit"
 cat > build/input_quick_exit.txt <<'EOF'
@@ -187,6 +205,83 @@ printf "ALG MAX_FLOW\nV 2\nE 1\nEDGE 0 1 1\nPARAM SRC 0\nPARAM SINK 0\nEND\n" |
 echo "[24] Unsupported ALG again"
 printf "ALG UNKNOWNALG\nV 2\nE 0\nEND\n" | nc -N 127.0.0.1 9090 || true
 
+# ---------- MAX_FLOW sessions (each answer checked against a fresh solve) ----------
+echo "[24.1] MAX_FLOW session: built, then updated with a lowered and a raised capacity"
+for c in 3 1 6; do
+  g="ALG MAX_FLOW\nV 4 DIRECTED 1\nE 4\nEDGE 0 1 $c\nEDGE 1 3 5\nEDGE 0 2 2\nEDGE 2 3 2\nPARAM SRC 0\nPARAM SINK 3\n"
+  ask "maxflow_session_$c" "${g}PARAM SESSION 7\nEND\n"
+  ask "maxflow_fresh_$c" "${g}END\n"
+  expect_same "MAX_FLOW session, capacity $c" "maxflow_session_$c" "maxflow_fresh_$c"
+done
+
+echo "[24.2] MAX_FLOW session on graphs with self-loops (directed pair, directed next to a real arc, undirected)"
+i=0
+for g in "V 3 DIRECTED 1\nE 4\nEDGE 0 1 5\nEDGE 1 2 5\nEDGE 1 1 100\nEDGE 1 1 100\nPARAM SRC 0\nPARAM SINK 2\n" \
+         "V 3 DIRECTED 1\nE 5\nEDGE 0 1 5\nEDGE 1 0 5\nEDGE 1 1 7\nEDGE 1 1 7\nEDGE 0 2 1\nPARAM SRC 1\nPARAM SINK 0\n" \
+         "V 3 DIRECTED 0\nE 3\nEDGE 0 1 5\nEDGE 1 1 100\nEDGE 1 2 3\nPARAM SRC 0\nPARAM SINK 1\n"; do
+  i=$((i + 1))
+  ask "maxflow_loop_session_$i" "ALG MAX_FLOW\n${g}PARAM SESSION $((20 + i))\nEND\n"
+  ask "maxflow_loop_fresh_$i" "ALG MAX_FLOW\n${g}END\n"
+  expect_same "MAX_FLOW session with self-loops #$i" "maxflow_loop_session_$i" "maxflow_loop_fresh_$i"
+done
+expect_text "MAX_FLOW undirected self-loop value" "maxflow_loop_session_3" "OK\nRESULT 5\nEND"
+
+# ---------- MAX_CLIQUES (answer streamed in one OK ... END block) ----------
+echo "[24.3] MAX_CLIQUES: full list, summary of cliques >= 3, bad MIN_SIZE"
+g="ALG MAX_CLIQUES\nV 6 DIRECTED 0\nE 8\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 1 2 1\nEDGE 1 3 1\nEDGE 2 3 1\nEDGE 0 3 1\nEDGE 3 4 1\nEDGE 2 4 1\n"
+ask max_cliques_list "${g}END\n"
+expect_text "MAX_CLIQUES full list" max_cliques_list "OK\nCLIQUE 5\nCLIQUE 2 3 4\nCLIQUE 0 1 2 3\nRESULT 3\nMAX_SIZE 4\nMAXIMUM 0 1 2 3\nEND"
+ask max_cliques_summary "${g}PARAM MIN_SIZE 3\nPARAM LIST 0\nEND\n"
+expect_text "MAX_CLIQUES summary (MIN_SIZE 3, LIST 0)" max_cliques_summary "OK\nRESULT 2\nMAX_SIZE 4\nMAXIMUM 0 1 2 3\nEND"
+ask max_cliques_bad_min "${g}PARAM MIN_SIZE 0\nEND\n"
+expect_text "MAX_CLIQUES MIN_SIZE 0" max_cliques_bad_min "ERR\nException: MIN_SIZE must be at least 1\nEND"
+
+echo "[24.4] MAX_CLIQUES on a dense 300-vertex graph (answer sent in several pieces)"
+{ printf "ALG MAX_CLIQUES\nV 300 DIRECTED 0\nE 13440\n"
+  awk 'BEGIN { for (u = 0; u < 300; u++) for (v = u + 1; v < 300; v++) if ((u * 31 + v * 17) % 10 < 3) print "EDGE " u " " v " 1" }'
+  printf "END\n"; } | nc -N 127.0.0.1 9090 > build/max_cliques_big.out 2> build/max_cliques_big.err || true
+f=build/max_cliques_big.out
+if [ "$(head -n 1 "$f")" != "OK" ] || [ "$(tail -n 1 "$f")" != "END" ] || [ "$(grep -c '^OK$' "$f")" != 1 ] \
+   || [ "$(grep -c '^CLIQUE ' "$f")" != "$(sed -n 's/^RESULT //p' "$f")" ]; then
+  echo "[!] MAX_CLIQUES streamed answer is not one OK ... END block listing RESULT cliques"
+  FAILS=$((FAILS + 1))
+fi
+
+# ---------- SCC sessions (PARAM SESSION / PARAM INSERT 1) ----------
+echo "[24.5] SCC session: insert before the session exists, base path, back arcs closing cycles, V and orientation mismatches"
+ask scc_session_early "ALG SCC\nV 4 DIRECTED 1\nE 1\nEDGE 3 1 1\nPARAM SESSION 8\nPARAM INSERT 1\nEND\n"
+expect_text "SCC INSERT before the session has a graph" scc_session_early "ERR\nException: SCC session 8 has no graph yet (send it without INSERT first)\nEND"
+ask scc_session_base "ALG SCC\nV 4 DIRECTED 1\nE 3\nEDGE 0 1 1\nEDGE 1 2 1\nEDGE 2 3 1\nPARAM SESSION 8\nEND\n"
+expect_text "SCC session base path" scc_session_base "OK\nRESULT 4\nEND"
+ask scc_session_cycle "ALG SCC\nV 4 DIRECTED 1\nE 1\nEDGE 3 1 1\nPARAM SESSION 8\nPARAM INSERT 1\nEND\n"
+expect_text "SCC INSERT closing the cycle 1-2-3" scc_session_cycle "OK\nRESULT 2\nEND"
+ask scc_session_bad_v "ALG SCC\nV 5 DIRECTED 1\nE 1\nEDGE 3 1 1\nPARAM SESSION 8\nPARAM INSERT 1\nEND\n"
+expect_text "SCC INSERT with another V" scc_session_bad_v "ERR\nException: graph does not match the session (V or orientation changed)\nEND"
+ask scc_session_bad_dir "ALG SCC\nV 4 DIRECTED 0\nE 1\nEDGE 3 0 1\nPARAM SESSION 8\nPARAM INSERT 1\nEND\n"
+expect_text "SCC INSERT of an undirected graph" scc_session_bad_dir "ERR\nException: graph does not match the session (V or orientation changed)\nEND"
+ask scc_session_all "ALG SCC\nV 4 DIRECTED 1\nE 1\nEDGE 3 0 1\nPARAM SESSION 8\nPARAM INSERT 1\nEND\n"
+expect_text "SCC INSERT closing the whole path (after rejected inserts)" scc_session_all "OK\nRESULT 1\nEND"
+
+# ---------- MIN_CUT ----------
+echo "[24.6] MIN_CUT on a directed graph (cut 5 = 1->3 + 2->4) and on an undirected one"
+ask min_cut "ALG MIN_CUT\nV 5 DIRECTED 1\nE 6\nEDGE 0 1 3\nEDGE 0 2 2\nEDGE 1 2 1\nEDGE 1 3 2\nEDGE 2 4 3\nEDGE 3 4 4\nPARAM SRC 0\nPARAM SINK 4\nEND\n"
+expect_text "MIN_CUT" min_cut "OK\nRESULT 5\nSOURCE_SIDE 0 1 2\nCUT 1 3 2\nCUT 2 4 3\nEND"
+ask min_cut_undirected "ALG MIN_CUT\nV 2 DIRECTED 0\nE 1\nEDGE 0 1 3\nEND\n"
+expect_text "MIN_CUT on an undirected graph" min_cut_undirected "OK\nRESULT 3\nSOURCE_SIDE 0\nCUT 0 1 3\nEND"
+
+# ---------- GOMORY_HU ----------
+echo "[24.7] GOMORY_HU: tree listing, the same min-cut query twice (cached tree), a graph differing in one weight, a directed graph"
+ask gomory_hu_tree "ALG GOMORY_HU\nV 4 DIRECTED 0\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nEDGE 0 2 1\nEDGE 1 3 2\nEND\n"
+expect_text "GOMORY_HU tree" gomory_hu_tree "OK\nRESULT 3\nTREE 1 0 4\nTREE 2 1 5\nTREE 3 2 6\nEND"
+for n in 1 2; do
+  ask gomory_hu_cut_$n "ALG GOMORY_HU\nV 4 DIRECTED 0\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nEDGE 0 2 1\nEDGE 1 3 2\nPARAM SRC 0\nPARAM SINK 3\nEND\n"
+  expect_text "GOMORY_HU min cut 0-3, query $n" gomory_hu_cut_$n "OK\nRESULT 4\nEND"
+done
+ask gomory_hu_other "ALG GOMORY_HU\nV 4 DIRECTED 0\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 1\nEDGE 0 2 1\nEDGE 1 3 2\nPARAM SRC 0\nPARAM SINK 3\nEND\n"
+expect_text "GOMORY_HU on a graph differing in one weight (no stale tree)" gomory_hu_other "OK\nRESULT 3\nEND"
+ask gomory_hu_directed "ALG GOMORY_HU\nV 2 DIRECTED 1\nE 1\nEDGE 0 1 3\nEND\n"
+expect_text "GOMORY_HU on a directed graph" gomory_hu_directed "ERR\nException: Gomory-Hu tree needs an undirected graph\nEND"
+
 # ---------- Bind failure (perror(bind)) ----------
 echo "[25] Bind failure"
 nc -l 9091 >/dev/null 2>&1 &
@@ -240,3 +335,8 @@ echo "[38] Timeout at 'again' prompt"
 { printf "2\n2\n0\n"; sleep ; } | ./client > build/client_timeout_again.out 2> build/client_timeout_again.err || true
 
 echo " All test runs completed."
+
+if [ "$FAILS" -ne 0 ]; then
+  echo "[!] $FAILS checked answers were wrong"
+  exit 1
+fi
@@ -5,7 +5,7 @@ Purpose: a simple factory that returns the right algorithm object based on a str
 
 Steps:
 * Copies id to up and uppercases it (case-insensitive matching).
-* Compares up to known names: MAX_FLOW, CLIQUES, SCC, MST.
+* Compares up to known names: MAX_FLOW, MAX_FLOW_PR, MIN_CUT, GOMORY_HU, CLIQUES, MAX_CLIQUES, SCC, SCC_DAG, MST.
 * For a match, returns a std::unique_ptr to the corresponding adapter (e.g., MaxFlowAlgo).
 * If no match, returns nullptr
 */
@@ -14,8 +14,13 @@ std::unique_ptr<IAlgorithm> AlgorithmFactory::create(const std::string& id)
     std::string up = id;
     std::transform(up.begin(), up.end(), up.begin(), ::toupper); // Uppercases the whole id string in-place so matching is case-insensitive
     if (up == "MAX_FLOW") return std::make_unique<MaxFlowAlgo>();
+    if (up == "MAX_FLOW_PR") return std::make_unique<MaxFlowPushRelabelAlgo>();
+    if (up == "MIN_CUT") return std::make_unique<MinCutAlgo>();
+    if (up == "GOMORY_HU") return std::make_unique<GomoryHuAlgo>();
     if (up == "CLIQUES") return std::make_unique<CliquesAlgo>();
+    if (up == "MAX_CLIQUES") return std::make_unique<MaxCliquesAlgo>();
     if (up == "SCC") return std::make_unique<SCCAlgo>();
+    if (up == "SCC_DAG") return std::make_unique<SCCDagAlgo>();
     if (up == "MST") return std::make_unique<MSTAlgo>();
     return nullptr;
 }
@@ -15,8 +15,13 @@ It uses the Factory Design Pattern to encapsulate the creation logic.
 #include <string>
 #include "IAlgorithm.hpp"
 #include "MaxFlowAlgo.hpp"
+#include "MaxFlowPushRelabelAlgo.hpp"
+#include "MinCutAlgo.hpp"
+#include "GomoryHuAlgo.hpp"
 #include "CliquesAlgo.hpp"
+#include "MaxCliquesAlgo.hpp"
 #include "SCCAlgo.hpp"
+#include "SCCDagAlgo.hpp"
 #include "MSTAlgo.hpp"
 #include <algorithm>
 
@@ -6,6 +6,14 @@
 
 @description: This file contains the CliquesAlgo class that implements the IAlgorithm interface
 to find the number of cliques of size k in a given graph.
+The kernel is chosen with PARAM KERNEL (0 = auto, 1 = sorted lists, 2 = bitset); auto picks the
+bitset kernel whenever its per-root bit matrix fits in memory.
+PARAM THREADS n (n > 1) counts on n threads with work stealing over the root vertices.
+n is capped at the number of cores.
+
+PARAM APPROX 1 estimates the count instead (edge sampling, see Finding_Num_Cliques.hpp) and stops at
+PARAM EPS percent relative error (default 5) or after PARAM BUDGET_MS milliseconds (default 1000):
+RESULT <estimate> CI95 <low> <high> SAMPLED <edges counted>/<edges>
 */
 
 
@@ -13,6 +21,7 @@ to find the number of cliques of size k in a given graph.
 #pragma once
 #include "IAlgorithm.hpp"
 #include "Finding_Num_Cliques.hpp"
+#include <cmath>
 
 class CliquesAlgo : public IAlgorithm 
 {
@@ -24,8 +33,42 @@ public:
     std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
     {
         int k = params.count("K") ? params.at("K") : 3; // Reads K from params (defaults to 3)
+        int kernel = params.count("KERNEL") ? params.at("KERNEL") : CLIQUES_AUTO; // Reads KERNEL from params (defaults to auto)
+        if (kernel < CLIQUES_AUTO || kernel > CLIQUES_BITSET)
+        {
+            throw std::invalid_argument("unknown clique KERNEL " + std::to_string(kernel));
+        }
+        if (params.count("APPROX") && params.at("APPROX") != 0)
+        {
+            return runApprox(g, k, params);
+        }
+        int threads = params.count("THREADS") ? params.at("THREADS") : 1; // Reads THREADS from params (defaults to one thread)
+        if (threads < 0)
+        {
+            throw std::invalid_argument("THREADS must not be negative");
+        }
         FindingNumCliques algo; // Instantiates the algorithm class
-        int res = algo.countCliques(g, k); // Executes the algorithm
+        long long res = algo.countCliques(g, k, static_cast<CliqueKernel>(kernel), threads); // Executes the algorithm
         return "RESULT " + std::to_string(res); // Returns the result
     }
+
+private:
+    std::string runApprox(const Graph& g, int k, const std::unordered_map<std::string,int>& params)
+    {
+        int eps = params.count("EPS") ? params.at("EPS") : 5; // Reads EPS (percent) from params (defaults to 5%)
+        int budget = params.count("BUDGET_MS") ? params.at("BUDGET_MS") : 1000; // Reads BUDGET_MS from params (defaults to 1 s)
+        if (eps < 0)
+        {
+            throw std::invalid_argument("EPS must not be negative");
+        }
+        if (budget <= 0)
+        {
+            throw std::invalid_argument("BUDGET_MS must be positive");
+        }
+        FindingNumCliques algo;
+        CliqueEstimate est = algo.estimateCliques(g, k, eps / 100.0, budget);
+        return "RESULT " + std::to_string(std::llround(est.estimate)) +
+               " CI95 " + std::to_string((long long)std::floor(est.low)) + " " + std::to_string((long long)std::ceil(est.high)) +
+               " SAMPLED " + std::to_string(est.sampled) + "/" + std::to_string(est.edges);
+    }
 };
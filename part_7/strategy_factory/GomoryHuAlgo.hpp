@@ -0,0 +1,129 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: This file contains the GomoryHuAlgo class that implements the IAlgorithm interface
+to answer min-cut queries on an undirected graph from its Gomory-Hu tree.
+Requested as ALG GOMORY_HU:
+* with PARAM SRC and PARAM SINK it answers "RESULT <min s-t cut value>";
+* without them it answers "RESULT <V-1>" followed by the tree, one "TREE <v> <parent> <weight>"
+  line per non-root vertex.
+ENGINE/THREADS are read as for MAX_FLOW and apply to the V-1 flow runs of the build.
+
+Trees are cached for the lifetime of the server process, keyed by the graph's fingerprint.
+Each entry keeps a copy of its graph's CSR arrays, and a fingerprint hit is only taken once
+they compare equal, so a hash collision cannot hand back another graph's tree. Repeated queries
+on the same graph cost one O(V + E) fingerprint and comparison plus an O(V) tree walk.
+*/
+
+#pragma once
+#include "IAlgorithm.hpp"
+#include "MaxFlowAlgo.hpp"
+#include "Gomory_Hu_Tree.hpp"
+#include <list>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+// Number of trees kept; the least recently used one is dropped first
+#define GOMORY_HU_CACHE_SIZE 16
+
+class GomoryHuAlgo : public IAlgorithm
+{
+public:
+    std::string id() const override
+    {
+        return "GOMORY_HU";
+    }
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override
+    {
+        int threads = 0;
+        MaxFlowEngine engine = MaxFlowAlgo::readEngine(params, threads);
+        std::shared_ptr<const GomoryHuTree> tree = cachedTree(g, engine, threads);
+
+        if (params.count("SRC") && params.count("SINK"))
+        {
+            return "RESULT " + std::to_string(tree->minCut(params.at("SRC"), params.at("SINK")));
+        }
+        std::ostringstream out;
+        out << "RESULT " << tree->get_vertices() - 1;
+        for (int v = 1; v < tree->get_vertices(); ++v)
+        {
+            out << "\nTREE " << v << ' ' << tree->parent_of(v) << ' ' << tree->weight_to_parent(v);
+        }
+        return out.str();
+    }
+
+private:
+    // The graph a cached tree was built from: its fingerprint plus everything the fingerprint hashes
+    struct CacheKey
+    {
+        unsigned long long fingerprint;
+        int vertices;
+        bool directed;
+        std::vector<int> offsets, targets, weights;
+
+        CacheKey(unsigned long long fp, const Graph& g)
+            : fingerprint(fp), vertices(g.get_vertices()), directed(g.is_directed()),
+              offsets(g.get_offsets().begin(), g.get_offsets().end()),
+              targets(g.get_targets().begin(), g.get_targets().end()),
+              weights(g.get_weights().begin(), g.get_weights().end())
+        {
+        }
+
+        bool matches(unsigned long long fp, const Graph& g) const
+        {
+            return fingerprint == fp && vertices == g.get_vertices() && directed == g.is_directed() &&
+                   same(offsets, g.get_offsets()) && same(targets, g.get_targets()) && same(weights, g.get_weights());
+        }
+
+    private:
+        static bool same(const std::vector<int>& kept, IntSpan span)
+        {
+            return (int)kept.size() == span.size() && std::equal(kept.begin(), kept.end(), span.begin());
+        }
+    };
+
+    /*
+    Returns the tree of g, building it on a miss. The build runs outside the lock, so queries
+    on other graphs are not held up by it; two racing misses on one graph both build and the
+    second insert is dropped.
+    */
+    static std::shared_ptr<const GomoryHuTree> cachedTree(const Graph& g, MaxFlowEngine engine, int threads)
+    {
+        static std::mutex mu;
+        static std::list<std::pair<CacheKey, std::shared_ptr<const GomoryHuTree>>> lru; // most recent first
+
+        unsigned long long fp = GomoryHuTree::fingerprint(g);
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            for (auto it = lru.begin(); it != lru.end(); ++it)
+            {
+                if (it->first.matches(fp, g))
+                {
+                    lru.splice(lru.begin(), lru, it);
+                    return lru.front().second;
+                }
+            }
+        }
+
+        auto tree = std::make_shared<const GomoryHuTree>(GomoryHuTree::build(g, engine, threads));
+        CacheKey key(fp, g);
+        std::lock_guard<std::mutex> lock(mu);
+        for (auto& entry : lru)
+        {
+            if (entry.first.matches(fp, g))
+            {
+                return entry.second;
+            }
+        }
+        lru.emplace_front(std::move(key), tree);
+        if (lru.size() > GOMORY_HU_CACHE_SIZE)
+        {
+            lru.pop_back();
+        }
+        return tree;
+    }
+};
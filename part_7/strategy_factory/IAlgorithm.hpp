@@ -7,12 +7,15 @@
 @ description: This file contains the interface IAlgorithm for different graph algorithms.
 Each algorithm must implement the id() method to return a stable identifier,
 and the run() method to execute the algorithm on a given graph with parameters.
+Algorithms with long answers (e.g. MAX_CLIQUES) also override runStreamed(), which hands the
+answer out in pieces so a server can send each one as soon as it is ready.
 */
 
 #pragma once
 
 #include <string>
 #include <unordered_map>
+#include <functional>
 
 #include "../../part_1/graph_impl.hpp"
 
@@ -26,4 +29,14 @@ public:
 
     // A pure virtual method all algorithms must implement to execute on a graph:
     virtual std::string run(const Graph& g, const std::unordered_map<std::string, int>& params) = 0; 
+
+    // Receives one piece of a streamed answer
+    using ChunkSink = std::function<void(const std::string&)>;
+
+    // Runs the algorithm and passes its answer to emit in order; the pieces joined are exactly what run() returns.
+    // The default emits run()'s answer as a single piece.
+    virtual void runStreamed(const Graph& g, const std::unordered_map<std::string, int>& params, const ChunkSink& emit)
+    {
+        emit(run(g, params));
+    }
 };
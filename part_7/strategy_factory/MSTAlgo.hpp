@@ -6,6 +6,17 @@
 
 @description: This file contains the MSTAlgo class that implements the IAlgorithm interface
 to find the weight of the Minimum Spanning Tree (MST) in a given graph.
+The engine is chosen with PARAM MST_ENGINE (0 = auto, 1 = Kruskal with radix-sorted edges, 2 = Prim with
+an indexed heap, undirected graphs only, 3 = parallel Boruvka); auto uses Prim on dense undirected graphs
+and Kruskal otherwise. PARAM THREADS n (n > 1) sets Boruvka's team size (at most one thread
+per core), and turns auto into Boruvka.
+A disconnected graph has no spanning tree: the answer is then a minimum spanning forest, one tree per
+connected component, and says how many trees it has. PARAM LIST 1 also lists the chosen edges.
+
+Output:
+RESULT <total weight> [FOREST <trees>]      (FOREST only when the graph is not connected)
+EDGE <u> <v> <w>                            (with PARAM LIST 1, sorted by u then v)
+...
 */
 
 #pragma once
@@ -19,10 +30,44 @@ public:
     { 
         return "MST"; 
     }
-    std::string run(const Graph& g, const std::unordered_map<std::string,int>&) override 
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
     {
+        // Reads MST_ENGINE from params (defaults to auto); not ENGINE, which ALG ALL passes to MAX_FLOW as well
+        int engine = params.count("MST_ENGINE") ? params.at("MST_ENGINE") : MST_AUTO;
+        if (engine < MST_AUTO || engine > MST_BORUVKA)
+        {
+            throw std::invalid_argument("unknown MST_ENGINE " + std::to_string(engine));
+        }
+        int threads = params.count("THREADS") ? params.at("THREADS") : 1; // Reads THREADS from params (defaults to one thread)
+        if (threads < 0)
+        {
+            throw std::invalid_argument("THREADS must not be negative");
+        }
+        if (engine == MST_AUTO && threads > 1)
+        {
+            engine = MST_BORUVKA;
+        }
+        bool list = params.count("LIST") && params.at("LIST") != 0; // Reads LIST from params (defaults to the summary only)
+
         MSTWeight algo; // Instantiates the algorithm class
-        int res = algo.findMSTWeight(g); // Executes the algorithm
-        return "RESULT " + std::to_string(res); // Returns the result
+        SpanningForest forest = algo.findSpanningForest(g, static_cast<MSTEngine>(engine), threads); // Executes the algorithm (64-bit total)
+
+        std::string out = "RESULT " + std::to_string(forest.weight);
+        if (forest.trees > 1)
+        {
+            out += " FOREST " + std::to_string(forest.trees);
+        }
+        if (list)
+        {
+            std::sort(forest.edges.begin(), forest.edges.end(), [](const GraphEdge& a, const GraphEdge& b)
+            {
+                return a.u != b.u ? a.u < b.u : a.v < b.v;
+            });
+            for (const GraphEdge& e : forest.edges)
+            {
+                out += "\nEDGE " + std::to_string(e.u) + " " + std::to_string(e.v) + " " + std::to_string(e.w);
+            }
+        }
+        return out; // Returns the result
     }
 };
@@ -0,0 +1,77 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: This file contains the MaxCliquesAlgo class that implements the IAlgorithm interface
+to list the maximal cliques of a graph and find a maximum one (see Finding_Max_Cliques.hpp).
+Requested as ALG MAX_CLIQUES. Parameters:
+* PARAM MIN_SIZE m: only cliques of at least m vertices are listed and counted (default 1).
+* PARAM LIST 0: skip the CLIQUE lines and answer with the summary only.
+
+Output (the CLIQUE lines are streamed in pieces of about 64 KB while the search runs):
+CLIQUE <v> <v> ...
+...
+RESULT <number of maximal cliques listed>
+MAX_SIZE <size of a maximum clique>
+MAXIMUM <v> <v> ...
+*/
+
+#pragma once
+#include "IAlgorithm.hpp"
+#include "Finding_Max_Cliques.hpp"
+
+class MaxCliquesAlgo : public IAlgorithm
+{
+public:
+    std::string id() const override
+    {
+        return "MAX_CLIQUES";
+    }
+
+    // The whole answer as one string (the streamed pieces joined)
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override
+    {
+        std::string out;
+        runStreamed(g, params, [&out](const std::string& piece) { out += piece; });
+        return out;
+    }
+
+    void runStreamed(const Graph& g, const std::unordered_map<std::string,int>& params, const ChunkSink& emit) override
+    {
+        const size_t chunkBytes = 64 * 1024;
+        int minSize = params.count("MIN_SIZE") ? params.at("MIN_SIZE") : 1; // Reads MIN_SIZE from params (defaults to 1)
+        bool list = params.count("LIST") ? params.at("LIST") != 0 : true;  // Reads LIST from params (defaults to listing)
+
+        std::string chunk;
+        FindingMaxCliques algo; // Instantiates the algorithm class
+        MaxCliquesSummary summary = algo.enumerate(g, [&](const std::vector<int>& clique)
+        {
+            if (!list)
+            {
+                return;
+            }
+            chunk += "CLIQUE";
+            for (int v : clique)
+            {
+                chunk += ' ';
+                chunk += std::to_string(v);
+            }
+            chunk += '\n';
+            if (chunk.size() >= chunkBytes)
+            {
+                emit(chunk); // hand a full piece over instead of growing one big answer
+                chunk.clear();
+            }
+        }, minSize);
+
+        chunk += "RESULT " + std::to_string(summary.count);
+        chunk += "\nMAX_SIZE " + std::to_string(summary.maximum.size());
+        chunk += "\nMAXIMUM";
+        for (int v : summary.maximum)
+        {
+            chunk += ' ';
+            chunk += std::to_string(v);
+        }
+        emit(chunk);
+    }
+};
@@ -5,13 +5,27 @@
 @date: 18-10-2025
 
 @description: This file contains the MaxFlowAlgo class that implements the IAlgorithm interface
-to find the maximum flow in a given graph using the Edmonds-Karp algorithm.
+to find the maximum flow in a given graph.
+The engine is chosen with PARAM ENGINE (0 = auto, 1 = Edmonds-Karp, 2 = Dinic, 3 = push-relabel,
+4 = parallel push-relabel); auto uses Dinic on sparse graphs and push-relabel on dense ones.
+PARAM THREADS n (n > 1) runs push-relabel (auto or 3) on n threads; it also sets the team size of engine 4.
+The team is capped at the number of cores, so a huge n cannot exhaust the server's threads.
+PARAM SESSION id keeps the residual network between requests: a graph resubmitted under the same id
+(same V, orientation, SRC and SINK) is diffed against the previous one and only the changed
+capacities are re-solved (see Max_Flow_Session.hpp). ENGINE/THREADS do not apply to sessions.
 
 */
 
 #pragma once
 #include "IAlgorithm.hpp"
 #include "Finding_Max_Flow.hpp"
+#include "Max_Flow_Session.hpp"
+#include <list>
+#include <memory>
+#include <mutex>
+
+// Number of max-flow sessions kept; the least recently used one is dropped first
+#define MAX_FLOW_SESSIONS 16
 
 class MaxFlowAlgo : public IAlgorithm 
 {
@@ -24,9 +38,88 @@ public:
     {
         int src = params.count("SRC") ? params.at("SRC") : 0; // Reads SRC from params (defaults to 0)
         int sink = params.count("SINK") ? params.at("SINK") : g.get_vertices()-1; // Reads SINK from params (defaults to last vertex)
+        if (params.count("SESSION"))
+        {
+            return "RESULT " + std::to_string(solveInSession(params.at("SESSION"), g, src, sink));
+        }
+        int threads = 0;
+        MaxFlowEngine engine = readEngine(params, threads);
         FindingMaxFlow algo; // Instantiates the algorithm class
-        Graph gCopy = g; // make a modifiable copy for algorithms that mutate the graph
-        int res = algo.findMaxFlow(gCopy, src, sink); // Executes the algorithm
+        int res = algo.findMaxFlow(g, src, sink, engine, threads); // Executes the algorithm (the graph is only read)
         return "RESULT " + std::to_string(res); // Returns the result
     }
+
+    /*
+    Reads ENGINE and THREADS (shared with MinCutAlgo); throws std::invalid_argument on bad values.
+    THREADS > 1 turns auto / push-relabel into the parallel push-relabel engine.
+    */
+    static MaxFlowEngine readEngine(const std::unordered_map<std::string,int>& params, int& threads)
+    {
+        int engine = params.count("ENGINE") ? params.at("ENGINE") : MAXFLOW_AUTO; // Reads ENGINE from params (defaults to auto)
+        threads = params.count("THREADS") ? params.at("THREADS") : 0; // Reads THREADS from params (0 = single-threaded engines)
+        if (engine < MAXFLOW_AUTO || engine > MAXFLOW_PARALLEL_PUSH_RELABEL)
+        {
+            throw std::invalid_argument("unknown max-flow ENGINE " + std::to_string(engine));
+        }
+        if (threads < 0)
+        {
+            throw std::invalid_argument("THREADS must not be negative");
+        }
+        if (threads > 1 && (engine == MAXFLOW_AUTO || engine == MAXFLOW_PUSH_RELABEL))
+        {
+            engine = MAXFLOW_PARALLEL_PUSH_RELABEL; // more than one thread asked for: use the parallel push-relabel
+        }
+        return static_cast<MaxFlowEngine>(engine);
+    }
+
+private:
+    struct Session
+    {
+        std::mutex mu; // one request at a time per session
+        std::unique_ptr<MaxFlowSession> flow;
+    };
+
+    /*
+    Finds (or creates) session 'id' and brings it up to date with g. A session whose shape does not
+    match the request (V, orientation, source or sink) is rebuilt from scratch.
+    Sessions are shared by all connections of the server process.
+    */
+    static int solveInSession(int id, const Graph& g, int src, int sink)
+    {
+        static std::mutex mu;
+        static std::list<std::pair<int, std::shared_ptr<Session>>> lru; // most recent first
+
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            auto it = lru.begin();
+            while (it != lru.end() && it->first != id)
+            {
+                ++it;
+            }
+            if (it != lru.end())
+            {
+                lru.splice(lru.begin(), lru, it);
+            }
+            else
+            {
+                lru.emplace_front(id, std::make_shared<Session>());
+                if (lru.size() > MAX_FLOW_SESSIONS)
+                {
+                    lru.pop_back();
+                }
+            }
+            session = lru.front().second;
+        }
+
+        std::lock_guard<std::mutex> lock(session->mu);
+        MaxFlowSession* flow = session->flow.get();
+        if (flow && flow->get_vertices() == g.get_vertices() && flow->is_directed() == g.is_directed()
+            && flow->get_source() == src && flow->get_sink() == sink)
+        {
+            return flow->update(g);
+        }
+        session->flow = std::make_unique<MaxFlowSession>(g, src, sink);
+        return session->flow->flow();
+    }
 };
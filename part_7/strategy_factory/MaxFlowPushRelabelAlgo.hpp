@@ -0,0 +1,32 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@date: 18-10-2025
+
+@description: This file contains the MaxFlowPushRelabelAlgo class that implements the IAlgorithm interface
+to find the maximum flow in a given graph with the highest-label push-relabel engine
+(global relabeling + gap heuristic), regardless of the graph's density.
+Requested as ALG MAX_FLOW_PR; takes the same SRC/SINK parameters as MAX_FLOW.
+*/
+
+#pragma once
+#include "IAlgorithm.hpp"
+#include "Finding_Max_Flow.hpp"
+
+class MaxFlowPushRelabelAlgo : public IAlgorithm 
+{
+public:
+    std::string id() const override
+    {
+        return "MAX_FLOW_PR"; 
+    }
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
+    {
+        int src = params.count("SRC") ? params.at("SRC") : 0; // Reads SRC from params (defaults to 0)
+        int sink = params.count("SINK") ? params.at("SINK") : g.get_vertices()-1; // Reads SINK from params (defaults to last vertex)
+        FindingMaxFlow algo; // Instantiates the algorithm class
+        int res = algo.findMaxFlow(g, src, sink, MAXFLOW_PUSH_RELABEL); // Executes the algorithm
+        return "RESULT " + std::to_string(res); // Returns the result
+    }
+};
@@ -0,0 +1,52 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: This file contains the MinCutAlgo class that implements the IAlgorithm interface
+to find a minimum s-t cut together with the max-flow value, from a single max-flow run.
+Requested as ALG MIN_CUT; takes the same SRC/SINK/ENGINE/THREADS parameters as MAX_FLOW.
+
+Output (one line per cut edge, in increasing order of the tail vertex):
+RESULT <flow>
+SOURCE_SIDE <v> <v> ...
+CUT <u> <v> <capacity>
+...
+*/
+
+#pragma once
+#include "IAlgorithm.hpp"
+#include "MaxFlowAlgo.hpp"
+#include <sstream>
+
+class MinCutAlgo : public IAlgorithm
+{
+public:
+    std::string id() const override
+    {
+        return "MIN_CUT";
+    }
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override
+    {
+        int src = params.count("SRC") ? params.at("SRC") : 0; // Reads SRC from params (defaults to 0)
+        int sink = params.count("SINK") ? params.at("SINK") : g.get_vertices()-1; // Reads SINK from params (defaults to last vertex)
+        int threads = 0;
+        MaxFlowEngine engine = MaxFlowAlgo::readEngine(params, threads);
+        FindingMaxFlow algo; // Instantiates the algorithm class
+        MinCut cut = algo.findMinCut(g, src, sink, engine, threads); // Executes the algorithm
+
+        std::ostringstream out;
+        out << "RESULT " << cut.flow << "\nSOURCE_SIDE";
+        for (int v = 0; v < (int)cut.sourceSide.size(); ++v)
+        {
+            if (cut.sourceSide[v])
+            {
+                out << ' ' << v;
+            }
+        }
+        for (const GraphEdge& e : cut.edges)
+        {
+            out << "\nCUT " << e.u << ' ' << e.v << ' ' << e.w;
+        }
+        return out.str();
+    }
+};
@@ -6,12 +6,24 @@
 
 @description: This file contains the SCCAlgo class that implements the IAlgorithm interface
 to find the strongly connected components (SCC) in a given graph.
-
+PARAM THREADS n (n > 1) finds them with the parallel engine on n threads (at most one per core);
+the count is the same.
+PARAM SESSION id keeps the components between requests (see SCC_Session.hpp): a request without
+PARAM INSERT (re)starts the session from its graph, and one with PARAM INSERT 1 adds its arcs to
+the session's graph instead (same V and orientation), merging components where they close cycles.
+THREADS does not apply to sessions.
 */
 
 #pragma once
 #include "IAlgorithm.hpp"
 #include "Finding_SCC.hpp"
+#include "SCC_Session.hpp"
+#include <list>
+#include <memory>
+#include <mutex>
+
+// Number of SCC sessions kept; the least recently used one is dropped first
+#define SCC_SESSIONS 16
 
 class SCCAlgo : public IAlgorithm 
 {
@@ -20,10 +32,78 @@ public:
     {
         return "SCC"; 
     }
-    std::string run(const Graph& g, const std::unordered_map<std::string,int>&) override 
+    std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
     {
+        if (params.count("SESSION"))
+        {
+            bool insert = params.count("INSERT") && params.at("INSERT") != 0;
+            return "RESULT " + std::to_string(countInSession(params.at("SESSION"), g, insert));
+        }
+        int threads = params.count("THREADS") ? params.at("THREADS") : 1; // Reads THREADS from params (defaults to one thread)
+        if (threads < 0)
+        {
+            throw std::invalid_argument("THREADS must not be negative");
+        }
         FindingSCC algo; // Instantiates the algorithm class
-        auto sccs = algo.findSCCs(g); // Executes the algorithm
-        return "RESULT " + std::to_string((int)sccs.size()); // Returns the result
+        std::vector<int> comp;
+        int count = threads > 1 ? algo.labelSCCsParallel(g, comp, threads)
+                                : algo.labelSCCs(g, comp); // Executes the algorithm (iterative, any depth)
+        return "RESULT " + std::to_string(count); // Returns the result
+    }
+
+private:
+    struct Session
+    {
+        std::mutex mu; // one request at a time per session
+        std::unique_ptr<SCCSession> scc;
+    };
+
+    /*
+    Finds (or creates) session 'id'. With insert, g's arcs are added to the session's graph, which
+    must exist and have g's V and orientation (std::invalid_argument otherwise); without it the
+    session restarts from g. Sessions are shared by all connections of the server process.
+    */
+    static int countInSession(int id, const Graph& g, bool insert)
+    {
+        static std::mutex mu;
+        static std::list<std::pair<int, std::shared_ptr<Session>>> lru; // most recent first
+
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            auto it = lru.begin();
+            while (it != lru.end() && it->first != id)
+            {
+                ++it;
+            }
+            if (it != lru.end())
+            {
+                lru.splice(lru.begin(), lru, it);
+            }
+            else
+            {
+                lru.emplace_front(id, std::make_shared<Session>());
+                if (lru.size() > SCC_SESSIONS)
+                {
+                    lru.pop_back();
+                }
+            }
+            session = lru.front().second;
+        }
+
+        std::lock_guard<std::mutex> lock(session->mu);
+        if (!insert)
+        {
+            session->scc = std::make_unique<SCCSession>(g);
+        }
+        else if (!session->scc)
+        {
+            throw std::invalid_argument("SCC session " + std::to_string(id) + " has no graph yet (send it without INSERT first)");
+        }
+        else
+        {
+            session->scc->insert(g);
+        }
+        return session->scc->count();
     }
 };
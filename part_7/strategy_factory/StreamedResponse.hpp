@@ -0,0 +1,81 @@
+/*
+@ author : Roy Meoded
+@ author : Yarin Keshet
+
+@ date: 18-10-2025
+
+@ description: This file contains the socket side of IAlgorithm::runStreamed(), shared by the
+servers of parts 7-9. send_streamed() runs an algorithm and writes its answer to a client in the
+usual OK ... END block, one piece at a time as the algorithm hands them over.
+*/
+
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "IAlgorithm.hpp"
+
+// Helper function for sending a whole buffer (send() may take only part of a large one)
+inline bool send_all(int fd, const std::string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+/*
+Helper function for running an algorithm and streaming its answer: the OK line goes out with the
+first piece, and each piece is sent as soon as the algorithm hands it over, so a long answer
+(MAX_CLIQUES) never has to be built whole. An exception before the first piece is rethrown for the
+caller's usual ERR reply; a later one closes the block with an "Error: ..." line.
+*/
+inline void send_streamed(int fd, IAlgorithm &algo, const Graph &g, const std::unordered_map<std::string,int> &params)
+{
+    bool started = false;
+    char last = '\n';
+    auto emit = [&](const std::string &piece)
+    {
+        if (!started)
+        {
+            started = true;
+            if (!send_all(fd, "OK\n")) throw std::runtime_error("client connection lost");
+        }
+        if (!piece.empty())
+        {
+            if (!send_all(fd, piece)) throw std::runtime_error("client connection lost"); // stop the search
+            last = piece.back();
+        }
+    };
+    try
+    {
+        algo.runStreamed(g, params, emit);
+        emit("");
+    }
+    catch (const std::exception &ex)
+    {
+        if (!started)
+        {
+            throw;
+        }
+        send_all(fd, std::string(last == '\n' ? "" : "\n") + "Error: " + ex.what() + "\nEND\n");
+        return;
+    }
+    send_all(fd, last == '\n' ? "END\n" : "\nEND\n");
+}
@@ -162,11 +162,11 @@ static string trim_cr(string s)
     return s;
 }
 
-// Helper function for running an algorithm and handling errors
-static string run_alg_or_error(const string& alg, const Graph& g, const unordered_map<string,int>& params, bool requestedDirected)
+// Helper function for checking that an algorithm fits the graph's orientation ("" when it does)
+static string orientation_error(const string& alg, bool requestedDirected)
 {
     // directed-required algorithms
-    bool isDirectedAlg = (alg=="MAX_FLOW" || alg=="SCC");
+    bool isDirectedAlg = (alg=="MAX_FLOW" || alg=="MAX_FLOW_PR" || alg=="MIN_CUT" || alg=="SCC" || alg=="SCC_DAG");
     bool okForThisGraph = (requestedDirected && isDirectedAlg) || (!requestedDirected && !isDirectedAlg);
     if (!okForThisGraph) 
     {
@@ -174,6 +174,17 @@ static string run_alg_or_error(const string& alg, const Graph& g, const unordere
         er << "Error: cannot run " << alg << " on " << (requestedDirected?"directed":"undirected") << " graph";
         return er.str();
     }
+    return "";
+}
+
+// Helper function for running an algorithm and handling errors
+static string run_alg_or_error(const string& alg, const Graph& g, const unordered_map<string,int>& params, bool requestedDirected)
+{
+    string err = orientation_error(alg, requestedDirected);
+    if (!err.empty())
+    {
+        return err;
+    }
     auto ptr = AlgorithmFactory::create(alg);
     if (!ptr)
     {
@@ -182,59 +193,49 @@ static string run_alg_or_error(const string& alg, const Graph& g, const unordere
     return ptr->run(g, params);
 }
 
+// Same as run_alg_or_error, but the answer is streamed to the client as it is produced
+static void stream_alg_or_error(int fd, const string& alg, const Graph& g, const unordered_map<string,int>& params, bool requestedDirected)
+{
+    string err = orientation_error(alg, requestedDirected);
+    if (!err.empty())
+    {
+        send_response(fd, err, true);
+        return;
+    }
+    auto ptr = AlgorithmFactory::create(alg);
+    if (!ptr)
+    {
+        send_response(fd, "Unsupported algorithm", true);
+        return;
+    }
+    send_streamed(fd, *ptr, g, params);
+}
+
 // Helper function for serializing graph edges
 static std::string serialize_graph_edges(const Graph& g, bool directed)
 {
-    const auto& cap = g.get_capacity();
-    std::ostringstream out;
+    // Walk the CSR arrays directly: O(V + E) instead of scanning a V x V matrix.
+    const IntSpan offsets = g.get_offsets();
+    const IntSpan targets = g.get_targets();
+    const IntSpan weights = g.get_weights();
+    std::ostringstream body;
     int V = g.get_vertices();
     int count = 0;
-    // First count edges for header
-    if (directed) 
+    for (int u=0; u<V; ++u)
     {
-        for (int u=0; u<V; ++u)
+        for (int i=offsets[u]; i<offsets[u+1]; ++i)
         {
-            for (int v=0; v<V; ++v)
+            int v = targets[i];
+            // Undirected edges are stored in both directions; print each once (u < v)
+            if (weights[i] > 0 && (directed || u < v))
             {
-                if (cap[u][v] > 0)
-                {
-                    ++count;
-                }
+                body << "EDGE " << u << " " << v << " " << weights[i] << "\n";
+                ++count;
             }
-        } 
-    }
-    else 
-    {
-        for (int u=0; u<V; ++u)
-        {
-            for (int v=u+1; v<V; ++v)
-            {
-                if (cap[u][v] > 0 || cap[v][u] > 0)
-                {
-                    ++count;
-                }
-            }
-        } 
-    }
-    out << "GRAPH " << V << " " << count << "\n";
-    if (directed) 
-    {
-        for (int u=0; u<V; ++u)
-        {
-           for (int v=0; v<V; ++v)
-           {
-               if (cap[u][v] > 0) out << "EDGE " << u << " " << v << " " << cap[u][v] << "\n";
-           }
-        } 
-    }
-    else 
-    {
-        for (int u=0; u<V; ++u) for (int v=u+1; v<V; ++v) 
-        {
-            int w = cap[u][v] > 0 ? cap[u][v] : cap[v][u];
-            if (w > 0) out << "EDGE " << u << " " << v << " " << w << "\n";
         }
     }
+    std::ostringstream out;
+    out << "GRAPH " << V << " " << count << "\n" << body.str();
     return out.str();
 }
 
@@ -290,12 +291,10 @@ void handle_client(int fd)
         int randomFlag=0;           // 0=use provided EDGE lines, 1=generate random graph
         int seed=42;                // seed for deterministic random graph
         int src=-1,sink=-1,k=-1;    // optional algorithm parameters
+        unordered_map<string,int> extraParams; // other PARAM keys, forwarded as-is
         int wmin=1,wmax=1;          // weight range for random graph
-        struct Edge
-        {
-            int u,v,w;             // explicit edges when RANDOM=0
-        };
-        vector<Edge> edges;
+        string graphFile;           // FILE <path>: load a binary CSR graph instead of EDGE/RANDOM
+        vector<GraphEdge> edges;    // explicit edges when RANDOM=0
         bool parse_error=false;
         string perr;
 
@@ -356,6 +355,10 @@ void handle_client(int fd)
                 std::istringstream ls(line);
                 string t; ls>>t>>wmin;
             }
+            else if (line.rfind("FILE ",0)==0) 
+            {
+                graphFile = line.substr(5); // the rest of the line is the path
+            }
             else if (line.rfind("WMAX ",0)==0) 
             {
                 std::istringstream ls(line);
@@ -364,12 +367,13 @@ void handle_client(int fd)
             }
             else if (line.rfind("PARAM ",0)==0) 
             {
-                // PARAM SRC|SINK|K value
+                // PARAM SRC|SINK|K value, any other key (e.g. ENGINE) is passed through to the algorithm
                 std::istringstream ls(line);
                 string t,kstr; int val; ls>>t>>kstr>>val;
                 if(kstr=="SRC")src=val;
                 else if(kstr=="SINK")sink=val;
                 else if(kstr=="K")k=val;
+                else if(ls)extraParams[kstr]=val;
             }
             else if (line.empty()) 
             {
@@ -390,7 +394,7 @@ void handle_client(int fd)
             send_response(fd, perr, false);
             continue; 
         }
-        if (V<=0) 
+        if (V<=0 && graphFile.empty()) // a FILE request takes V from the file header
         {
             send_response(fd, "Missing/invalid V", false);
             continue; 
@@ -404,10 +408,18 @@ void handle_client(int fd)
         // 5–7) Build + params + dispatch, with validation and exception safety
         try
         {
-            // 5) Build the Graph according to the request (explicit edges or generated random)
-            Graph g(V, directed!=0);
+            // 5) Build the Graph according to the request (file, explicit edges or generated random)
+            Graph g(1, directed!=0);
 
-            if (!randomFlag)
+            if (!graphFile.empty())
+            {
+                // FILE: mmap the binary CSR (zero-copy); V and DIRECTED come from the file header.
+                // The path is confined to the data directory (see graph_file_path.hpp)
+                g = Graph::load_binary(resolve_graph_file(graphFile));
+                V = g.get_vertices();
+                directed = g.is_directed() ? 1 : 0;
+            }
+            else if (!randomFlag)
             {
                 // Validate all explicit edges BEFORE addEdge to avoid abort/throw inside Graph
                 bool bad = false;
@@ -432,24 +444,21 @@ void handle_client(int fd)
                     continue;
                 }
 
-                // Now it's safe to add
-                for (const auto &e : edges)
-                {
-                    g.addEdge(e.u, e.v, e.w);
-                }
+                // Now it's safe to build the CSR from the whole edge list at once
+                g = Graph::from_edge_list(V, directed!=0, edges);
             }
             else
             {
                 // RANDOM=1: clamp E to a feasible range, normalize weight range, then generate.
-                int maxE = directed ? V*(V-1) : V*(V-1)/2; // maximum simple edges possible
-                if (E > maxE) { E = maxE; }
+                long long maxE = directed ? 1LL*V*(V-1) : 1LL*V*(V-1)/2; // maximum simple edges possible
+                if (E > maxE) { E = (int)maxE; }
                 if (E < 0)     { E = 0;    }
                 if (wmax < wmin) { std::swap(wmax, wmin); }
                 g = generate_random_graph(V, E, seed, directed!=0, wmin, wmax);
             }
 
             // 6) Prepare algorithm parameters map (only include provided keys)
-            unordered_map<string,int> params;
+            unordered_map<string,int> params = extraParams;
             if (src  >= 0) { params["SRC"]  = src;  }
             if (sink >= 0) { params["SINK"] = sink; }
             if (k    >= 0) { params["K"]    = k;    }
@@ -477,9 +486,8 @@ void handle_client(int fd)
             }
             else
             {
-                // Single-algorithm request
-                auto out = run_alg_or_error(alg, g, params, directed!=0);
-                send_response(fd, out, true);
+                // Single-algorithm request (long answers such as MAX_CLIQUES go out piece by piece)
+                stream_alg_or_error(fd, alg, g, params, directed!=0);
             }
         }
         catch (const std::exception& ex)
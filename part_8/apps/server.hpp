@@ -20,7 +20,9 @@
 
 #include "../../part_1/graph_impl.hpp"
 #include "../include/random_graph.hpp"
+#include "../include/graph_file_path.hpp"
 #include "../../part_7/strategy_factory/AlgorithmFactory.hpp"
+#include "../../part_7/strategy_factory/StreamedResponse.hpp" // send_streamed
 
 
 
@@ -41,6 +41,24 @@ cleanup() {
 }
 trap cleanup EXIT
 
+# ─────────────────────  Checked answers (the script fails at the end if any differ)  ─────────────────────
+FAILS=0
+ask() { # ask <name> <request in printf format>: answer goes to $LOG_DIR/<name>.out
+  printf "$2" | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/$1.out" 2> "$LOG_DIR/$1.err" || true
+}
+expect_text() { # expect_text <label> <name> <answer in printf format>
+  if [ "$(cat "$LOG_DIR/$2.out")" != "$(printf "$3")" ]; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "$LOG_DIR/$2.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+expect_match() { # expect_match <label> <name> <grep -E pattern the whole answer, joined by spaces, must match>
+  if ! tr '\n' ' ' < "$LOG_DIR/$2.out" | grep -Eq "$3"; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "$LOG_DIR/$2.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+
 # Verify the server actually started
 if ! kill -0 "$SERVER_PID" 2>/dev/null; then
   echo "[!] Server failed to start. Dumping $LOG_DIR/server.err:"
@@ -358,4 +376,45 @@ echo "[40] EDGE with non-numeric weight"
 printf "ALG MST\nDIRECTED 0\nV 3\nE 1\nEDGE 0 1 X\nEND\n" \
   | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_edge_weight_nonnumeric.out" 2> "$LOG_DIR/raw_edge_weight_nonnumeric.err" || true
 
+# [41] Server: FILE with a missing path / a file that is not a graph file
+echo "[41] FILE missing / bad magic"
+printf "ALG PREVIEW\nFILE ./no_such_graph.bin\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_file_missing.out" 2> "$LOG_DIR/raw_file_missing.err" || true
+printf "ALG PREVIEW\nFILE ./client\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_file_bad_magic.out" 2> "$LOG_DIR/raw_file_bad_magic.err" || true
+
+# [42] Server: FILE confined to the data directory (the server's working directory here)
+echo "[42] FILE: valid graph, link to it, ../x, absolute path, link leaving the directory, truncated file, bad header"
+i32() { printf "\\x$(printf %02x $(($1 & 255)))\\x$(printf %02x $((($1 >> 8) & 255)))\\x$(printf %02x $((($1 >> 16) & 255)))\\x$(printf %02x $((($1 >> 24) & 255)))"; }
+i64() { i32 "$1"; i32 0; }
+graph_file() { # graph_file <arcs in the header>: directed 0->1 of weight 5, V=2, E=1, arrays at 64/128/192
+  printf 'OSGRAPH\0'; i32 1; i32 1; i64 2; i64 1; i64 "$1"; i64 64; i64 128; i64 192
+  i32 0; i32 1; i32 1; head -c 52 /dev/zero; i32 1; head -c 60 /dev/zero; i32 5
+}
+mkdir -p "$LOG_DIR/graphs"
+graph_file 1 > "$LOG_DIR/graphs/g.bin"
+graph_file 2 > "$LOG_DIR/graphs/bad_header.bin"
+head -c 40 "$LOG_DIR/graphs/g.bin" > "$LOG_DIR/graphs/truncated.bin"
+ln -sfn g.bin "$LOG_DIR/graphs/g_link.bin"
+ln -sfn /etc "$LOG_DIR/graphs/etc_link"
+for f in g g_link; do
+  ask "raw_file_$f" "ALG MAX_FLOW\nFILE $LOG_DIR/graphs/$f.bin\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+  expect_text "FILE $f.bin" "raw_file_$f" "OK\nRESULT 5\nEND"
+done
+ask raw_file_dotdot "ALG MAX_FLOW\nFILE ../x\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+expect_match "FILE ../x" raw_file_dotdot '^ERR .*may not leave the data directory'
+ask raw_file_absolute "ALG MAX_FLOW\nFILE /etc/passwd\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+expect_match "FILE /etc/passwd" raw_file_absolute '^ERR .*must be a relative path'
+ask raw_file_link_out "ALG MAX_FLOW\nFILE $LOG_DIR/graphs/etc_link/passwd\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+expect_match "FILE through a link leaving the directory" raw_file_link_out '^ERR .*resolves outside'
+ask raw_file_truncated "ALG MAX_FLOW\nFILE $LOG_DIR/graphs/truncated.bin\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+expect_match "FILE truncated" raw_file_truncated '^ERR .*graph file too small'
+ask raw_file_bad_header "ALG MAX_FLOW\nFILE $LOG_DIR/graphs/bad_header.bin\nPARAM SRC 0\nPARAM SINK 1\nEND\n"
+expect_match "FILE with arcs != edges" raw_file_bad_header '^ERR .*corrupt graph file header'
+
 echo " All test runs completed."
+
+if [ "$FAILS" -ne 0 ]; then
+  echo "[!] $FAILS checked answers were wrong"
+  exit 1
+fi
@@ -0,0 +1,58 @@
+#pragma once
+#include <climits>  // PATH_MAX
+#include <cerrno>
+#include <cstdlib>  // getenv, realpath
+#include <cstring>  // strerror
+#include <stdexcept>
+#include <string>
+
+/*
+FILE <path> lets a network client choose a file on the server, so the path is confined to one data
+directory: $GRAPH_DATA_DIR, or the server's working directory when it is not set. The path must be
+relative and may not contain a ".." component, and once symlinks are resolved (realpath) it must
+still lie inside the resolved data directory, so a link in there cannot point elsewhere.
+Graph::load_binary then only accepts a regular file, so a FIFO or a device cannot block the
+request handler.
+Returns the resolved path to open; throws std::invalid_argument for a path outside the data
+directory or one that does not exist.
+*/
+inline std::string resolve_graph_file(const std::string& requested)
+{
+    if (requested.empty() || requested[0] == '/')
+    {
+        throw std::invalid_argument("FILE must be a relative path inside the data directory");
+    }
+    size_t start = 0;
+    while (start <= requested.size())
+    {
+        size_t end = requested.find('/', start);
+        if (end == std::string::npos)
+        {
+            end = requested.size();
+        }
+        if (requested.compare(start, end - start, "..") == 0)
+        {
+            throw std::invalid_argument("FILE may not leave the data directory (\"..\")");
+        }
+        start = end + 1;
+    }
+    const char* dir = std::getenv("GRAPH_DATA_DIR");
+    const std::string base = (dir == nullptr || *dir == '\0') ? "." : dir;
+
+    char resolved[PATH_MAX];
+    if (realpath(base.c_str(), resolved) == nullptr)
+    {
+        throw std::invalid_argument("data directory " + base + ": " + std::strerror(errno));
+    }
+    std::string root(resolved);
+    if (realpath((base + "/" + requested).c_str(), resolved) == nullptr)
+    {
+        throw std::invalid_argument("FILE " + requested + ": " + std::strerror(errno));
+    }
+    std::string path(resolved);
+    if (root != "/" && (path.compare(0, root.size(), root) != 0 || (path.size() > root.size() && path[root.size()] != '/')))
+    {
+        throw std::invalid_argument("FILE may not leave the data directory (it resolves outside it)");
+    }
+    return path;
+}
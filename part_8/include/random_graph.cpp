@@ -1,93 +1,286 @@
 #include "../include/random_graph.hpp"
+#include <cmath>
+#include <algorithm>
+#include <thread>
+
+/*
+Counter-based random stream (SplitMix64): output i is a fixed function of (key, i), so any block of the
+generation can be reproduced on any thread without replaying the ones before it.
+The key is derived from (seed, block index), which makes every block an independent stream.
+*/
+class CounterRng
+{
+public:
+    CounterRng(unsigned long long seed, unsigned long long stream)
+        : state(mix(mix(seed) ^ (stream * 0xd1b54a32d192ed03ULL + 0x9e3779b97f4a7c15ULL))) {}
+
+    unsigned long long next()
+    {
+        state += 0x9e3779b97f4a7c15ULL;
+        return mix(state);
+    }
+
+    // Uniform value in [0, n) (Lemire's multiply-shift with rejection, so there is no modulo bias)
+    unsigned long long below(unsigned long long n)
+    {
+        unsigned __int128 m = (unsigned __int128)next() * n;
+        unsigned long long low = (unsigned long long)m;
+        if (low < n)
+        {
+            unsigned long long threshold = (0 - n) % n;
+            while (low < threshold)
+            {
+                m = (unsigned __int128)next() * n;
+                low = (unsigned long long)m;
+            }
+        }
+        return (unsigned long long)(m >> 64);
+    }
+
+private:
+    static unsigned long long mix(unsigned long long z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    unsigned long long state;
+};
+
+/*
+Flat open-addressing hash set of edge indices (linear probing over a power-of-two table).
+Used instead of std::set: one flat allocation up front, no node per edge, O(1) expected lookups.
+*/
+class EdgeIndexSet
+{
+public:
+    explicit EdgeIndexSet(unsigned long long expected)
+    {
+        unsigned long long cap = 16;
+        while (cap < 2 * expected)
+        {
+            cap <<= 1; // keep the load factor at or below 1/2
+        }
+        slots.assign(cap, EMPTY);
+        mask = cap - 1;
+    }
+
+    // Inserts k; returns false if k was already in the set
+    bool insert(unsigned long long k)
+    {
+        unsigned long long i = hash(k) & mask;
+        while (slots[i] != EMPTY)
+        {
+            if (slots[i] == k)
+            {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i] = k;
+        return true;
+    }
+
+private:
+    static constexpr unsigned long long EMPTY = ~0ULL; // never a valid edge index
+
+    // 64-bit finalizer (MurmurHash3 fmix64) so consecutive indices spread over the table
+    static unsigned long long hash(unsigned long long k)
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    std::vector<unsigned long long> slots;
+    unsigned long long mask;
+};
+
+/*
+Samples 'count' distinct indices from [0, range) into out[0..count).
+Robert Floyd's algorithm: for j = range-count .. range-1 draw t in [0, j]; keep t if it is new,
+otherwise keep j (which cannot have been picked yet). That is exactly 'count' draws, with no rejection
+loop, so the cost does not blow up as the graph gets dense.
+Above 50% density the complement is sampled instead (the range-count indices to leave out), and the
+kept indices are enumerated in increasing order.
+*/
+static void sample_distinct(unsigned long long range, unsigned long long count, CounterRng& rng, unsigned long long* out)
+{
+    bool complement = count > range / 2;
+    unsigned long long pick = complement ? range - count : count;
+
+    std::vector<unsigned long long> skipped; // complement mode: the indices left out
+    unsigned long long* picked = out;
+    if (complement)
+    {
+        skipped.resize(pick);
+        picked = skipped.data();
+    }
+    EdgeIndexSet chosen(pick);
+    unsigned long long n = 0;
+    for (unsigned long long j = range - pick; j < range; ++j)
+    {
+        unsigned long long t = rng.below(j + 1);
+        if (!chosen.insert(t))
+        {
+            chosen.insert(j);
+            t = j;
+        }
+        picked[n++] = t;
+    }
+    if (!complement)
+    {
+        return;
+    }
+
+    // Enumerate [0, range) minus the sampled indices
+    std::sort(skipped.begin(), skipped.end());
+    size_t skip = 0;
+    n = 0;
+    for (unsigned long long k = 0; k < range; ++k)
+    {
+        if (skip < skipped.size() && skipped[skip] == k)
+        {
+            ++skip;
+            continue;
+        }
+        out[n++] = k;
+    }
+}
+
+/*
+Edge index -> endpoints.
+Undirected: the pairs u < v are numbered row by row; row u starts at u*(2V-u-1)/2.
+The row is estimated with the quadratic formula and then corrected for floating-point error.
+Directed: u = k / (V-1), and v runs over the V-1 vertices other than u.
+*/
+static void decode_undirected(unsigned long long k, unsigned long long V, int& u, int& v)
+{
+    auto row_start = [V](unsigned long long r) { return r * (2 * V - r - 1) / 2; };
+    double b = 2.0 * (double)V - 1.0;
+    double est = (b - std::sqrt(std::max(0.0, b * b - 8.0 * (double)k))) / 2.0;
+    unsigned long long r = est > 0 ? (unsigned long long)est : 0;
+    while (r > 0 && row_start(r) > k)
+    {
+        --r;
+    }
+    while (r + 1 < V && row_start(r + 1) <= k)
+    {
+        ++r;
+    }
+    u = (int)r;
+    v = (int)(r + 1 + (k - row_start(r)));
+}
+
+static void decode_directed(unsigned long long k, unsigned long long V, int& u, int& v)
+{
+    u = (int)(k / (V - 1));
+    unsigned long long r = k % (V - 1);
+    v = (int)(r < (unsigned long long)u ? r : r + 1); // skip the self-loop u->u
+}
+
+// Target number of edges per generation block (blocks are the unit of parallel work)
+#define RANDOM_GRAPH_BLOCK_EDGES 65536
 
 /*
     Generate a simple random graph with positive edge weights in [wmin, wmax].
     - vertices: number of vertices (0..vertices-1)
-    - edges: number of distinct edges to add
+    - edges: number of distinct edges to add (clamped to the number of possible edges)
     - seed: PRNG seed to make generation deterministic/repeatable
     - directed: if true, produce directed edges (u->v); otherwise undirected
     - wmin/wmax: inclusive weight range; wmin is normalized to be at least 1
+    - threads: worker threads (0 = hardware concurrency); the result does not depend on it
 
     Guarantees:
     - No self-loops (u != v)
-    - No duplicate edges: for undirected we avoid adding both (u,v) and (v,u);
-    for directed we avoid duplicate (u->v).
+    - No duplicate edges: every possible edge has one index in [0, maxE)
+    (maxE = V(V-1)/2 undirected, V(V-1) directed), and distinct indices are sampled directly.
+    - Same (vertices, edges, seed, directed, wmin, wmax) => bit-identical graph, for any thread count.
+
+    Parallel layout: the index space is cut into B equal blocks, where B depends only on the
+    number of edges (never on the thread count). Block b receives its proportional share of the
+    edges and samples them with its own counter-based stream keyed by (seed, b), then draws their
+    weights from the same stream. Blocks write to fixed slots of the edge list, so threads can
+    take any subset of blocks in any order.
 */
-Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax)
+Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax, int threads)
 {
     // Normalize weight range (ensure wmin <= wmax and wmin >= 1)
-    if (wmin > wmax) 
+    if (wmin > wmax)
     {
         std::swap(wmin, wmax);
     }
     if (wmin < 1)
     {
         wmin = 1; // keep positive weights/capacities
-    } 
+    }
+    unsigned long long wspan = (unsigned long long)wmax - (unsigned long long)wmin + 1;
+
+    // Size of the edge index space
+    unsigned long long V = vertices > 0 ? (unsigned long long)vertices : 0;
+    unsigned long long maxE = V > 1 ? (directed ? V * (V - 1) : V * (V - 1) / 2) : 0;
+    unsigned long long count = edges > 0 ? std::min((unsigned long long)edges, maxE) : 0;
 
-    // Prepare an empty graph with the requested orientation
-    Graph g(vertices, directed);
+    // Blocks: [lo_b, hi_b) of the index space, with count_b = count * (hi_b - lo_b) / maxE (rounded so they sum to count)
+    unsigned long long blocks = std::max(1ULL, std::min(maxE, (count + RANDOM_GRAPH_BLOCK_EDGES - 1) / RANDOM_GRAPH_BLOCK_EDGES));
+    auto bound = [&](unsigned long long b) { return (unsigned long long)((unsigned __int128)maxE * b / blocks); };
+    auto share = [&](unsigned long long b) { return maxE ? (unsigned long long)((unsigned __int128)count * bound(b) / maxE) : 0ULL; };
 
-    // RNG setup: deterministic PRNG seeded by 'seed'
-    std::mt19937 rng(seed);
-    // Uniformly pick endpoints in [0, vertices-1]
-    std::uniform_int_distribution<int> distV(0, vertices - 1);
-    // Uniformly pick weights in [wmin, wmax]
-    std::uniform_int_distribution<int> distW(wmin, wmax);
+    if (threads <= 0)
+    {
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = (int)std::min<unsigned long long>(threads, blocks);
 
-    if (!directed) 
+    // Collect the edges first; the graph is built from the whole list in one pass at the end
+    std::vector<GraphEdge> edgeList(count);
+    auto run_blocks = [&](unsigned long long first, unsigned long long last)
     {
-        // Undirected: track used unordered pairs (min(u,v), max(u,v)) to avoid duplicates
-        std::set<std::pair<int, int>> used_edges;
-        int added = 0;
-        while (added < edges)
+        std::vector<unsigned long long> idx;
+        for (unsigned long long b = first; b < last; ++b)
         {
-            int u = distV(rng);
-            int v = distV(rng);
-            if (u == v)
+            unsigned long long lo = bound(b);
+            unsigned long long at = share(b);
+            unsigned long long n = share(b + 1) - at;
+            CounterRng rng((unsigned long long)(long long)seed, b);
+            idx.resize(n);
+            sample_distinct(bound(b + 1) - lo, n, rng, idx.data());
+            for (unsigned long long i = 0; i < n; ++i)
             {
-                continue; // skip self-loops
+                int u, v;
+                if (directed)
+                {
+                    decode_directed(lo + idx[i], V, u, v);
+                }
+                else
+                {
+                    decode_undirected(lo + idx[i], V, u, v);
+                }
+                edgeList[at + i] = {u, v, wmin + (int)rng.below(wspan)};
             }
-            auto e = std::make_pair(std::min(u,v), std::max(u,v));
-            if (used_edges.count(e))
-            {
-                continue; // already have this undirected edge
-            }
-            int w = distW(rng);
-            g.addEdge(u, v, w);
-            used_edges.insert(e);
-            ++added;
         }
+    };
+
+    if (threads <= 1)
+    {
+        run_blocks(0, blocks);
     }
-    else 
+    else
     {
-        // Directed: track used ordered pairs via a compact 64-bit key (u,v)
-        std::set<long long> used;
-        // lambda for generating unique keys for edges:
-        auto key = [vertices](int u, int v)
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t)
         {
-             return (long long)u * (vertices + 1LL) + v; 
-        };
-        int added = 0;
-        while (added < edges)
+            pool.emplace_back(run_blocks, blocks * t / threads, blocks * (t + 1) / threads);
+        }
+        for (auto& th : pool)
         {
-            int u = distV(rng);
-            int v = distV(rng);
-            if (u == v)
-            {
-                continue; // skip self-loops
-            } 
-            long long k = key(u,v);
-            if (used.count(k))
-            {
-                continue; // already have u->v
-            }
-            int w = distW(rng);
-            g.addEdge(u, v, w);
-            used.insert(k);
-            ++added;
+            th.join();
         }
     }
-    // Return the generated graph
-    return g;
+    // Build and return the generated graph with the requested orientation
+    return Graph::from_edge_list(vertices, directed, edgeList, threads);
 }
@@ -3,5 +3,6 @@
 #include <random>
 #include <set>
 
-// Directed/undirected random graph generator with integer weights in [wmin,wmax]
-Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax);
+// Directed/undirected random graph generator with integer weights in [wmin,wmax].
+// Runs on 'threads' worker threads (0 = hardware concurrency); the graph depends only on the other arguments.
+Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax, int threads = 0);
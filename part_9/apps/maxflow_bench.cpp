@@ -0,0 +1,81 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@description: Max-flow benchmark. Generates a random directed graph and times the single-threaded
+push-relabel engine against the parallel push-relabel engine for 1, 2, 4, ... up to -t threads,
+checking that every run returns the same flow value.
+
+Usage: ./maxflow_bench -v <vertices> -e <edges> -s <seed> [-t <max threads>]
+*/
+
+#include "../../part_8/include/random_graph.hpp"
+#include "Finding_Max_Flow.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <unistd.h>   // getopt
+#include <cstdlib>    // std::atoi
+
+static void usage(const char* prog)
+{
+    std::cerr << "Usage: " << prog << " -v <vertices> -e <edges> -s <seed> [-t <max threads>]\n";
+}
+
+// Runs one engine and prints its flow value and wall time; returns the flow value
+static int timed_run(const Graph& g, MaxFlowEngine engine, int threads, const char* name)
+{
+    FindingMaxFlow algo;
+    auto t0 = std::chrono::steady_clock::now();
+    int flow = algo.findMaxFlow(g, 0, g.get_vertices() - 1, engine, threads);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << name << " threads=" << threads << " flow=" << flow << " time=" << ms << " ms\n";
+    return flow;
+}
+
+int main(int argc, char* argv[])
+{
+    int vertices = 0;
+    int edges = 0;
+    int seed = 0;
+    int maxThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+    bool hasV = false, hasE = false, hasS = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "v:e:s:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'v': vertices = std::atoi(optarg); hasV = true; break;
+            case 'e': edges = std::atoi(optarg); hasE = true; break;
+            case 's': seed = std::atoi(optarg); hasS = true; break;
+            case 't': maxThreads = std::atoi(optarg); break;
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (!hasV || !hasE || !hasS || vertices < 2 || edges < 0 || maxThreads < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Graph g = generate_random_graph(vertices, edges, seed, true, 1, 100);
+    std::cout << "Graph: V=" << g.get_vertices() << " arcs=" << g.get_arcs() << " source=0 sink=" << vertices - 1 << "\n";
+
+    int expected = timed_run(g, MAXFLOW_PUSH_RELABEL, 1, "push-relabel");
+    bool ok = true;
+    for (int t = 1; t <= maxThreads; t *= 2)
+    {
+        ok = (timed_run(g, MAXFLOW_PARALLEL_PUSH_RELABEL, t, "parallel push-relabel") == expected) && ok;
+    }
+    if (!ok)
+    {
+        std::cerr << "Error: flow values differ between engines\n";
+        return 1;
+    }
+    return 0;
+}
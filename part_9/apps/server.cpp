@@ -34,6 +34,8 @@ static void sigterm_handler(int) {;
 static std::string run_alg_or_error(const std::string& alg, const Graph& g,
                                     const std::unordered_map<std::string,int>& params,
                                     bool requestedDirected);
+static void stream_alg_or_error(int fd, const std::string& alg, const Graph& g,
+                                const std::unordered_map<std::string,int>& params, bool requestedDirected);
 static std::string serialize_graph_edges(const Graph& g, bool directed);
 static bool peer_already_closed_write(int fd);
 static int g_listen_fd = -1;
@@ -76,6 +78,28 @@ namespace
         }
     }
 
+    /*
+    Streamed answers can be very long, and a client that stops reading blocks whoever sends to it.
+    So they leave the stage: the job is streamed by a thread of its own while the stage goes on with
+    the jobs behind it, and the socket gets a send timeout, so a stalled reader ends the stream
+    ("client connection lost") instead of keeping that thread forever.
+    */
+    void stream_off_stage(Job job, const char* alg)
+    {
+        timeval tv{};
+        tv.tv_sec = STREAM_SEND_TIMEOUT_SEC;
+        setsockopt(job.fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        const int fd = job.fd;
+        try {
+            std::thread([job = std::move(job), alg]() {
+                stream_alg_or_error(job.fd, alg, job.graph, job.params, job.directed);
+                if (peer_already_closed_write(job.fd)) { close(job.fd); }
+            }).detach();
+        } catch (const std::exception& e) {
+            send_response(fd, string("Error: ") + e.what(), true); // no thread for it: answer instead of stalling the stage
+        }
+    }
+
     // Stage loops for each pipeline stage:
 
     // Max-Flow stage:
@@ -87,7 +111,7 @@ namespace
             //Wait for jobs and process them:
             while (q_max_flow.pop(job))
             {
-                job.res_max_flow = run_alg_or_error("MAX_FLOW", job.graph, job.params, job.directed); // run max-flow
+                job.res_max_flow = run_alg_or_error(job.max_flow_alg, job.graph, job.params, job.directed); // run max-flow
 
                 // If it is single max-flow request, send to aggregator, else to next stage:
                 if (job.kind == AlgKind::SINGLE_MAX_FLOW) q_agg.push(std::move(job)); 
@@ -110,6 +134,13 @@ namespace
             Job job;
             while (q_scc.pop(job))
             {
+                // SCC_DAG streams its arrays (several numbers per vertex) straight to the client, from its own
+                // thread, so a slow reader cannot hold up the SCC and ALL jobs behind it:
+                if (job.kind == AlgKind::SINGLE_SCC_DAG) {
+                    stream_off_stage(std::move(job), "SCC_DAG");
+                    continue;
+                }
+
                 job.res_scc = run_alg_or_error("SCC", job.graph, job.params, job.directed); // run SCC
 
                 // If single SCC request, send to aggregator, else to next stage:
@@ -147,6 +178,9 @@ namespace
         }
     }
 
+    // Threads the cliques stage counts with when a request has no PARAM THREADS (argv[2], default: all cores):
+    std::atomic<int> g_clique_threads{1};
+
     // Cliques stage:
     void stage_cliques_loop()
     {
@@ -154,7 +188,18 @@ namespace
             Job job;
             while (q_cliques.pop(job))
             {
-                job.res_cliques = run_alg_or_error("CLIQUES", job.graph, job.params, job.directed); // run cliques
+                // MAX_CLIQUES streams its (possibly huge) list straight to the client instead of through the aggregator,
+                // from its own thread, so a slow reader cannot hold up the CLIQUES and ALL jobs behind it:
+                if (job.kind == AlgKind::SINGLE_MAX_CLIQUES) {
+                    stream_off_stage(std::move(job), "MAX_CLIQUES");
+                    continue;
+                }
+
+                // The request's own PARAM THREADS wins over the server-wide setting:
+                std::unordered_map<std::string,int> params = job.params;
+                if (!params.count("THREADS")) params["THREADS"] = g_clique_threads.load();
+
+                job.res_cliques = run_alg_or_error("CLIQUES", job.graph, params, job.directed); // run cliques
                 // If single cliques request, send to aggregator:
                 q_agg.push(std::move(job));
             }
@@ -452,11 +497,12 @@ static string trim_cr(string s)
     return s;
 }
 
-// Helper function for running an algorithm and handling errors
-static string run_alg_or_error(const string& alg, const Graph& g,
-                               const unordered_map<string,int>& params, bool requestedDirected)
+// Helper function for checking a request before running it ("" when it can run)
+static string request_error(const string& alg, const Graph& g,
+                            const unordered_map<string,int>& params, bool requestedDirected)
 {
-    bool isDirectedAlg = (alg == "MAX_FLOW" || alg == "SCC");
+    bool isMaxFlow = (alg == "MAX_FLOW" || alg == "MAX_FLOW_PR" || alg == "MIN_CUT");
+    bool isDirectedAlg = (isMaxFlow || alg == "SCC" || alg == "SCC_DAG");
     bool okForThisGraph = (requestedDirected && isDirectedAlg) || (!requestedDirected && !isDirectedAlg);
     if (!okForThisGraph) {
         std::ostringstream er;
@@ -466,7 +512,7 @@ static string run_alg_or_error(const string& alg, const Graph& g,
 
     int V = g.get_vertices();
 
-    if (alg == "MAX_FLOW") {
+    if (isMaxFlow) {
         auto itS = params.find("SRC");
         auto itT = params.find("SINK");
         if (itS == params.end() || itT == params.end())
@@ -484,67 +530,75 @@ static string run_alg_or_error(const string& alg, const Graph& g,
         if (k < 2 || k > V)
             return "Error: invalid K for CLIQUES";
     }
+    return "";
+}
+
+// Helper function for running an algorithm and handling errors
+static string run_alg_or_error(const string& alg, const Graph& g,
+                               const unordered_map<string,int>& params, bool requestedDirected)
+{
+    string err = request_error(alg, g, params, requestedDirected);
+    if (!err.empty()) return err;
 
     // Create algorithm instance and run it, using the factory:
     auto ptr = AlgorithmFactory::create(alg);
     if (!ptr) return "Unsupported algorithm";
-    return ptr->run(g, params);
+    // A bad PARAM value must not take the whole pipeline stage down
+    try
+    {
+        return ptr->run(g, params);
+    }
+    catch (const std::exception& e)
+    {
+        return string("Error: ") + e.what();
+    }
+}
+
+// Same as run_alg_or_error, but the answer is streamed to the client as it is produced
+static void stream_alg_or_error(int fd, const string& alg, const Graph& g,
+                                const unordered_map<string,int>& params, bool requestedDirected)
+{
+    string err = request_error(alg, g, params, requestedDirected);
+    if (!err.empty()) { send_response(fd, err, true); return; }
+
+    auto ptr = AlgorithmFactory::create(alg);
+    if (!ptr) { send_response(fd, "Unsupported algorithm", true); return; }
+    try
+    {
+        send_streamed(fd, *ptr, g, params);
+    }
+    catch (const std::exception& e)
+    {
+        send_response(fd, string("Error: ") + e.what(), true); // failed before anything was sent
+    }
 }
 
 
 // Helper function for serializing graph edges
 static std::string serialize_graph_edges(const Graph& g, bool directed)
 {
-    const auto& cap = g.get_capacity();
-    std::ostringstream out;
+    // Walk the CSR arrays directly: O(V + E) instead of scanning a V x V matrix.
+    const IntSpan offsets = g.get_offsets();
+    const IntSpan targets = g.get_targets();
+    const IntSpan weights = g.get_weights();
+    std::ostringstream body;
     int V = g.get_vertices();
     int count = 0;
-    // First count edges for header
-    if (directed) 
-    {
-        for (int u=0; u<V; ++u)
-        {
-            for (int v=0; v<V; ++v)
-            {
-                if (cap[u][v] > 0)
-                {
-                    ++count;
-                }
-            }
-        } 
-    }
-    else 
+    for (int u=0; u<V; ++u)
     {
-        for (int u=0; u<V; ++u)
+        for (int i=offsets[u]; i<offsets[u+1]; ++i)
         {
-            for (int v=u+1; v<V; ++v)
+            int v = targets[i];
+            // Undirected edges are stored in both directions; print each once (u < v)
+            if (weights[i] > 0 && (directed || u < v))
             {
-                if (cap[u][v] > 0 || cap[v][u] > 0)
-                {
-                    ++count;
-                }
+                body << "EDGE " << u << " " << v << " " << weights[i] << "\n";
+                ++count;
             }
-        } 
-    }
-    out << "GRAPH " << V << " " << count << "\n";
-    if (directed) 
-    {
-        for (int u=0; u<V; ++u)
-        {
-           for (int v=0; v<V; ++v)
-           {
-               if (cap[u][v] > 0) out << "EDGE " << u << " " << v << " " << cap[u][v] << "\n";
-           }
-        } 
-    }
-    else 
-    {
-        for (int u=0; u<V; ++u) for (int v=u+1; v<V; ++v) 
-        {
-            int w = cap[u][v] > 0 ? cap[u][v] : cap[v][u];
-            if (w > 0) out << "EDGE " << u << " " << v << " " << w << "\n";
         }
     }
+    std::ostringstream out;
+    out << "GRAPH " << V << " " << count << "\n" << body.str();
     return out.str();
 }
 
@@ -588,12 +642,10 @@ void handle_client(int fd)
         int randomFlag=0;           // 0=use provided EDGE lines, 1=generate random graph
         int seed=42;                // seed for deterministic random graph
         int src=-1,sink=-1,k=-1;    // optional algorithm parameters
+        unordered_map<string,int> extraParams; // other PARAM keys, forwarded as-is
         int wmin=1,wmax=1;          // weight range for random graph
-        struct Edge
-        {
-            int u,v,w;             // explicit edges when RANDOM=0
-        };
-        vector<Edge> edges;
+        string graphFile;           // FILE <path>: load a binary CSR graph instead of EDGE/RANDOM
+        vector<GraphEdge> edges;    // explicit edges when RANDOM=0
         bool parse_error=false;
         string perr;
 
@@ -654,6 +706,10 @@ void handle_client(int fd)
                 std::istringstream ls(line);
                 string t; ls>>t>>wmin;
             }
+            else if (line.rfind("FILE ",0)==0) 
+            {
+                graphFile = line.substr(5); // the rest of the line is the path
+            }
             else if (line.rfind("WMAX ",0)==0) 
             {
                 std::istringstream ls(line);
@@ -662,12 +718,13 @@ void handle_client(int fd)
             }
             else if (line.rfind("PARAM ",0)==0) 
             {
-                // PARAM SRC|SINK|K value
+                // PARAM SRC|SINK|K value, any other key (e.g. ENGINE) is passed through to the algorithm
                 std::istringstream ls(line);
                 string t,kstr; int val; ls>>t>>kstr>>val;
                 if(kstr=="SRC")src=val;
                 else if(kstr=="SINK")sink=val;
                 else if(kstr=="K")k=val;
+                else if(ls)extraParams[kstr]=val;
             }
             else if (line.empty()) 
             {
@@ -689,6 +746,25 @@ void handle_client(int fd)
             if (peer_already_closed_write(fd)) { close(fd); return; }
             continue; 
         }
+
+        // FILE <path>: mmap a binary CSR graph; V and DIRECTED are taken from the file header
+        Graph g(1, directed!=0);
+        if (!graphFile.empty())
+        {
+            try
+            {
+                g = Graph::load_binary(resolve_graph_file(graphFile)); // confined to the data directory
+            }
+            catch (const std::exception& ex)
+            {
+                send_response(fd, string("Cannot load FILE: ") + ex.what(), false);
+                if (peer_already_closed_write(fd)) { close(fd); return; }
+                continue;
+            }
+            V = g.get_vertices();
+            directed = g.is_directed() ? 1 : 0;
+        }
+
         if (V<=0) 
         {
             send_response(fd, "Missing/invalid V", false);
@@ -696,9 +772,9 @@ void handle_client(int fd)
 
             continue; 
         }
-        // Upper bound guard to avoid pathological memory/CPU usage
-        // Keep under safe limits for WSL/CI; adjust if needed.
-        const int V_SAFE_MAX = 20000;
+        // Upper bound guard to avoid pathological memory/CPU usage.
+        // The CSR graph costs O(V + E), so this only bounds the offsets array.
+        const int V_SAFE_MAX = 50000000;
         if (V > V_SAFE_MAX) {
             send_response(fd, "V too large", false);
             if (peer_already_closed_write(fd)) { close(fd); return; }
@@ -712,9 +788,12 @@ void handle_client(int fd)
             continue; 
         }
 
-        // 5) Build the Graph according to the request (explicit edges or generated random)
-        Graph g(V, directed!=0);
-        if (!randomFlag) 
+        // 5) Build the Graph according to the request (file, explicit edges or generated random)
+        if (!graphFile.empty())
+        {
+            // already loaded above
+        }
+        else if (!randomFlag) 
         {
             // Validate all edges before touching Graph to avoid asserts/abort
             bool bad = false;
@@ -733,15 +812,14 @@ void handle_client(int fd)
                 send_response(fd, err, false);
                 continue; // back to read next request
             }
-            for (auto &e : edges) {
-                g.addEdge(e.u, e.v, e.w);
-            }
+            // Build the CSR from the whole edge list at once
+            g = Graph::from_edge_list(V, directed!=0, edges);
         }
         else 
         {
             // RANDOM=1: clamp and normalize then generate
-            int maxE = directed? V*(V-1) : V*(V-1)/2;
-            if (E > maxE) E = maxE;
+            long long maxE = directed? 1LL*V*(V-1) : 1LL*V*(V-1)/2;
+            if (E > maxE) E = (int)maxE;
             if (E < 0) E = 0;
             if (wmax < wmin) std::swap(wmax, wmin);
             g = generate_random_graph(V, E, seed, directed!=0, wmin, wmax);
@@ -749,7 +827,7 @@ void handle_client(int fd)
 
 
         // 6) Prepare algorithm parameters map (only include provided keys)
-        unordered_map<string,int> params;
+        unordered_map<string,int> params = extraParams;
         if(src>=0)
         {
             params["SRC"]=src;
@@ -773,9 +851,14 @@ void handle_client(int fd)
         if (alg == "PREVIEW"){ job.kind = AlgKind::PREVIEW; }
         else if (alg == "ALL"){ job.kind = AlgKind::ALL; }
         else if (alg == "MAX_FLOW"){ job.kind = AlgKind::SINGLE_MAX_FLOW; }
+        else if (alg == "MAX_FLOW_PR"){ job.kind = AlgKind::SINGLE_MAX_FLOW; job.max_flow_alg = alg; }
+        else if (alg == "MIN_CUT"){ job.kind = AlgKind::SINGLE_MAX_FLOW; job.max_flow_alg = alg; }
+        else if (alg == "GOMORY_HU"){ job.kind = AlgKind::SINGLE_MAX_FLOW; job.max_flow_alg = alg; }
         else if (alg == "SCC"){ job.kind = AlgKind::SINGLE_SCC; }
+        else if (alg == "SCC_DAG"){ job.kind = AlgKind::SINGLE_SCC_DAG; }
         else if (alg == "MST"){ job.kind = AlgKind::SINGLE_MST; }
         else if (alg == "CLIQUES"){ job.kind = AlgKind::SINGLE_CLIQUES; }
+        else if (alg == "MAX_CLIQUES"){ job.kind = AlgKind::SINGLE_MAX_CLIQUES; }
         else 
         {
             send_response(fd, "Unsupported algorithm", false);
@@ -796,7 +879,7 @@ void handle_client(int fd)
             q_max_flow.push(std::move(job));
         }
 
-        else if (job.kind == AlgKind::SINGLE_SCC) 
+        else if (job.kind == AlgKind::SINGLE_SCC || job.kind == AlgKind::SINGLE_SCC_DAG) 
         {
             q_scc.push(std::move(job));
         }
@@ -804,7 +887,7 @@ void handle_client(int fd)
         {
             q_mst.push(std::move(job));
         }
-        else if (job.kind == AlgKind::SINGLE_CLIQUES) 
+        else if (job.kind == AlgKind::SINGLE_CLIQUES || job.kind == AlgKind::SINGLE_MAX_CLIQUES) 
         {
             q_cliques.push(std::move(job));
         }
@@ -828,6 +911,17 @@ int run_server(int argc, char *argv[])
             port=p;
         }
     }
+    //    and the cliques stage's thread count via argv[2] (all hardware threads by default)
+    unsigned cores = std::thread::hardware_concurrency();
+    g_clique_threads = (cores == 0) ? 1 : (int)cores;
+    if (argc>=3)
+    {
+        int t=std::atoi(argv[2]);
+        if(t>0)
+        {
+            g_clique_threads=t;
+        }
+    }
 
     // 2) Create a TCP socket (IPv4, stream)
     int srv = socket(AF_INET, SOCK_STREAM, 0);
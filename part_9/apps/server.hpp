@@ -3,6 +3,7 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 #include <cerrno>
@@ -25,7 +26,9 @@
 #include "../../part_1/graph_impl.hpp"
 // Reuse Part 8's random graph interface; implementation will be linked via makefile sources.
 #include "../../part_8/include/random_graph.hpp"
+#include "../../part_8/include/graph_file_path.hpp"
 #include "../../part_7/strategy_factory/AlgorithmFactory.hpp"
+#include "../../part_7/strategy_factory/StreamedResponse.hpp" // send_streamed
 
 // Pipeline includes:
 #include "../include/blocking_queue.hpp"
@@ -35,6 +38,11 @@
 #define PORT 9090
 #endif
 
+// A streamed answer (MAX_CLIQUES, SCC_DAG) whose client accepts no data for this many seconds is dropped
+#ifndef STREAM_SEND_TIMEOUT_SEC
+#define STREAM_SEND_TIMEOUT_SEC 30
+#endif
+
 bool recv_all_lines(int fd, std::string &out);
 void send_response(int fd, const std::string &body, bool ok = true);
 
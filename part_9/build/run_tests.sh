@@ -85,6 +85,26 @@ fi
 NC_CLOSE_OPT="-N"; nc -h 2>&1 | grep -q -- "-N" || NC_CLOSE_OPT="-q 1"
 run_with_input() { local in="$1" out="$2" err="$3"; timeout 15s ./client < "$in" > "$out" 2> "$err" || true; }
 
+# Answers that are checked (not only run for coverage); the script fails at the end if any differ
+FAILS=0
+ask() { # ask <name> <request in printf format>: answer goes to $LOG_DIR/<name>.out
+  # -q 1 keeps the write side open: a connection whose client has already shut it down can be
+  # closed by its reader before the pipeline has sent the answer
+  printf "$2" | timeout 5s nc -q 1 -w 2 127.0.0.1 "$PORT" > "$LOG_DIR/$1.out" 2> "$LOG_DIR/$1.err" || true
+}
+expect_same() { # expect_same <label> <name> <name>: two answers must be identical
+  if ! cmp -s "$LOG_DIR/$2.out" "$LOG_DIR/$3.out"; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "$LOG_DIR/$2.out")' vs '$(tr '\n' ' ' < "$LOG_DIR/$3.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+expect_text() { # expect_text <label> <name> <answer in printf format>
+  if [ "$(cat "$LOG_DIR/$2.out")" != "$(printf "$3")" ]; then
+    echo "[!] $1: got '$(tr '\n' ' ' < "$LOG_DIR/$2.out")'"
+    FAILS=$((FAILS + 1))
+  fi
+}
+
 echo "[2] Client quick exit"
 cat > "$LOG_DIR/input_quick_exit.txt" <<'EOF'
 0
@@ -482,6 +502,16 @@ printf "ALG PREVIEW\nDIRECTED 1\nRANDOM 1\nV 3\nE 2\nSEED -42\nEND\n" \
  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
  > "$LOG_DIR/raw_seed_negative.out" 2> "$LOG_DIR/raw_seed_negative.err" || true
 
+echo "[24.24] FILE with a missing path"
+printf "ALG PREVIEW\nFILE ./no_such_graph.bin\nEND\n" \
+ | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+ > "$LOG_DIR/raw_file_missing.out" 2> "$LOG_DIR/raw_file_missing.err" || true
+
+echo "[24.25] FILE that is not a graph file (bad magic)"
+printf "ALG PREVIEW\nFILE ./client\nEND\n" \
+ | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+ > "$LOG_DIR/raw_file_bad_magic.out" 2> "$LOG_DIR/raw_file_bad_magic.err" || true
+
 
 # ======================  BlockingQueue header coverage  ==============
 echo "[25] BlockingQueue header unit test"
@@ -533,6 +563,61 @@ printf "ALG MAX_FLOW\nDIRECTED 1\nV 4\nE 2\nEDGE 0 1 1\nEDGE 1 2 1\nPARAM SRC 1\
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
   > "$LOG_DIR/raw_maxflow_src_eq_sink.out" 2> "$LOG_DIR/raw_maxflow_src_eq_sink.err" || true
 
+echo "[28.1] MAX_FLOW with an explicit engine (Dinic) / unknown engine"
+printf "ALG MAX_FLOW\nDIRECTED 1\nV 4\nE 3\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nPARAM SRC 0\nPARAM SINK 3\nPARAM ENGINE 2\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_maxflow_engine_dinic.out" 2> "$LOG_DIR/raw_maxflow_engine_dinic.err" || true
+printf "ALG MAX_FLOW\nDIRECTED 1\nV 4\nE 3\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nPARAM SRC 0\nPARAM SINK 3\nPARAM ENGINE 9\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_maxflow_engine_bad.out" 2> "$LOG_DIR/raw_maxflow_engine_bad.err" || true
+
+echo "[28.2] MAX_FLOW_PR (push-relabel engine)"
+printf "ALG MAX_FLOW_PR\nDIRECTED 1\nV 4\nE 3\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nPARAM SRC 0\nPARAM SINK 3\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_maxflow_pr.out" 2> "$LOG_DIR/raw_maxflow_pr.err" || true
+
+echo "[28.3] MAX_FLOW on two threads (parallel push-relabel)"
+printf "ALG MAX_FLOW\nDIRECTED 1\nV 5\nE 6\nEDGE 0 1 3\nEDGE 0 2 2\nEDGE 1 2 1\nEDGE 1 3 2\nEDGE 2 4 3\nEDGE 3 4 4\nPARAM SRC 0\nPARAM SINK 4\nPARAM THREADS 2\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_maxflow_threads.out" 2> "$LOG_DIR/raw_maxflow_threads.err" || true
+
+echo "[28.4] MIN_CUT (flow value, source side and cut edges), and on an undirected graph"
+ask raw_min_cut "ALG MIN_CUT\nDIRECTED 1\nV 5\nE 6\nEDGE 0 1 3\nEDGE 0 2 2\nEDGE 1 2 1\nEDGE 1 3 2\nEDGE 2 4 3\nEDGE 3 4 4\nPARAM SRC 0\nPARAM SINK 4\nEND\n"
+expect_text "MIN_CUT" raw_min_cut "OK\nRESULT 5\nSOURCE_SIDE 0 1 2\nCUT 1 3 2\nCUT 2 4 3\nEND"
+ask raw_min_cut_undirected "ALG MIN_CUT\nDIRECTED 0\nV 2\nE 1\nEDGE 0 1 3\nEND\n"
+expect_text "MIN_CUT on an undirected graph" raw_min_cut_undirected "OK\nError: cannot run MIN_CUT on undirected graph\nEND"
+
+echo "[28.5] GOMORY_HU: tree listing, the same min-cut query twice (cached tree), a graph differing in one weight, a directed graph"
+ask raw_gomory_hu_tree "ALG GOMORY_HU\nDIRECTED 0\nV 4\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nEDGE 0 2 1\nEDGE 1 3 2\nEND\n"
+expect_text "GOMORY_HU tree" raw_gomory_hu_tree "OK\nRESULT 3\nTREE 1 0 4\nTREE 2 1 5\nTREE 3 2 6\nEND"
+for n in 1 2; do
+  ask raw_gomory_hu_cut_$n "ALG GOMORY_HU\nDIRECTED 0\nV 4\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 4\nEDGE 0 2 1\nEDGE 1 3 2\nPARAM SRC 0\nPARAM SINK 3\nEND\n"
+  expect_text "GOMORY_HU min cut 0-3, query $n" raw_gomory_hu_cut_$n "OK\nRESULT 4\nEND"
+done
+ask raw_gomory_hu_other "ALG GOMORY_HU\nDIRECTED 0\nV 4\nE 5\nEDGE 0 1 3\nEDGE 1 2 2\nEDGE 2 3 1\nEDGE 0 2 1\nEDGE 1 3 2\nPARAM SRC 0\nPARAM SINK 3\nEND\n"
+expect_text "GOMORY_HU on a graph differing in one weight (no stale tree)" raw_gomory_hu_other "OK\nRESULT 3\nEND"
+ask raw_gomory_hu_directed "ALG GOMORY_HU\nDIRECTED 1\nV 2\nE 1\nEDGE 0 1 3\nEND\n"
+expect_text "GOMORY_HU on a directed graph" raw_gomory_hu_directed "OK\nError: cannot run GOMORY_HU on directed graph\nEND"
+
+echo "[28.6] MAX_FLOW session (same graph resubmitted with a lowered and a raised capacity), checked against fresh solves"
+for c in 3 1 6; do
+  g="ALG MAX_FLOW\nDIRECTED 1\nV 4\nE 4\nEDGE 0 1 $c\nEDGE 1 3 5\nEDGE 0 2 2\nEDGE 2 3 2\nPARAM SRC 0\nPARAM SINK 3\n"
+  ask "raw_maxflow_session_$c" "${g}PARAM SESSION 7\nEND\n"
+  ask "raw_maxflow_fresh_$c" "${g}END\n"
+  expect_same "MAX_FLOW session, capacity $c" "raw_maxflow_session_$c" "raw_maxflow_fresh_$c"
+done
+
+echo "[28.7] MAX_FLOW session on directed graphs with self-loops (a looped pair, a looped vertex next to a real arc)"
+i=0
+for g in "DIRECTED 1\nV 3\nE 4\nEDGE 0 1 5\nEDGE 1 2 5\nEDGE 1 1 100\nEDGE 1 1 100\nPARAM SRC 0\nPARAM SINK 2\n" \
+         "DIRECTED 1\nV 3\nE 5\nEDGE 0 1 5\nEDGE 1 0 5\nEDGE 1 1 7\nEDGE 1 1 7\nEDGE 0 2 1\nPARAM SRC 1\nPARAM SINK 0\n"; do
+  i=$((i + 1))
+  ask "raw_maxflow_loop_session_$i" "ALG MAX_FLOW\n${g}PARAM SESSION $((20 + i))\nEND\n"
+  ask "raw_maxflow_loop_fresh_$i" "ALG MAX_FLOW\n${g}END\n"
+  expect_same "MAX_FLOW session with self-loops #$i" "raw_maxflow_loop_session_$i" "raw_maxflow_loop_fresh_$i"
+done
+expect_text "MAX_FLOW session value with self-loops" "raw_maxflow_loop_session_2" "OK\nRESULT 5\nEND"
+
 echo "[29] CLIQUES invalid K (<2)"
 printf "ALG CLIQUES\nDIRECTED 0\nV 4\nE 3\nEDGE 0 1 1\nEDGE 1 2 1\nEDGE 2 3 1\nPARAM K 1\nEND\n" \
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
@@ -543,11 +628,117 @@ printf "ALG CLIQUES\nDIRECTED 0\nV 4\nE 6\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 0 3 1\nE
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
   > "$LOG_DIR/raw_cliques_k_gt_v.out" 2> "$LOG_DIR/raw_cliques_k_gt_v.err" || true
 
+echo "[30.1] CLIQUES K=3 with each kernel (auto, lists, bitset) and an unknown one"
+for kern in 0 1 2 7; do
+  printf "ALG CLIQUES\nDIRECTED 0\nV 5\nE 8\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 1 2 1\nEDGE 1 3 1\nEDGE 2 3 1\nEDGE 0 3 1\nEDGE 3 4 1\nEDGE 2 4 1\nPARAM K 3\nPARAM KERNEL $kern\nEND\n" \
+    | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_cliques_kernel.out" 2>> "$LOG_DIR/raw_cliques_kernel.err" || true
+done
+
+echo "[30.2] CLIQUES K=3 on 1, 3 and a negative number of threads"
+for thr in 1 3 -1; do
+  printf "ALG CLIQUES\nDIRECTED 0\nV 5\nE 8\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 1 2 1\nEDGE 1 3 1\nEDGE 2 3 1\nEDGE 0 3 1\nEDGE 3 4 1\nEDGE 2 4 1\nPARAM K 3\nPARAM THREADS $thr\nEND\n" \
+    | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_cliques_threads.out" 2>> "$LOG_DIR/raw_cliques_threads.err" || true
+done
+
+echo "[30.21] CLIQUES APPROX (small graph: sampled to the exact count), tight budget on a random graph, bad EPS"
+for extra in "PARAM EPS 1\n" "PARAM EPS -1\n" "PARAM BUDGET_MS 0\n"; do
+  printf "ALG CLIQUES\nDIRECTED 0\nV 5\nE 8\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 1 2 1\nEDGE 1 3 1\nEDGE 2 3 1\nEDGE 0 3 1\nEDGE 3 4 1\nEDGE 2 4 1\nPARAM K 3\nPARAM APPROX 1\n${extra}END\n" \
+    | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_cliques_approx.out" 2>> "$LOG_DIR/raw_cliques_approx.err" || true
+done
+printf "ALG CLIQUES\nRANDOM 1\nDIRECTED 0\nV 2000\nE 100000\nSEED 5\nPARAM K 4\nPARAM APPROX 1\nPARAM EPS 10\nPARAM BUDGET_MS 200\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  >> "$LOG_DIR/raw_cliques_approx.out" 2>> "$LOG_DIR/raw_cliques_approx.err" || true
+
+echo "[30.3] MAX_CLIQUES: full list, summary of cliques >= 3, bad MIN_SIZE, directed graph"
+g="ALG MAX_CLIQUES\nDIRECTED 0\nV 6\nE 8\nEDGE 0 1 1\nEDGE 0 2 1\nEDGE 1 2 1\nEDGE 1 3 1\nEDGE 2 3 1\nEDGE 0 3 1\nEDGE 3 4 1\nEDGE 2 4 1\n"
+ask raw_max_cliques_list "${g}END\n"
+expect_text "MAX_CLIQUES full list" raw_max_cliques_list "OK\nCLIQUE 5\nCLIQUE 2 3 4\nCLIQUE 0 1 2 3\nRESULT 3\nMAX_SIZE 4\nMAXIMUM 0 1 2 3\nEND"
+ask raw_max_cliques_summary "${g}PARAM MIN_SIZE 3\nPARAM LIST 0\nEND\n"
+expect_text "MAX_CLIQUES summary (MIN_SIZE 3, LIST 0)" raw_max_cliques_summary "OK\nRESULT 2\nMAX_SIZE 4\nMAXIMUM 0 1 2 3\nEND"
+ask raw_max_cliques_bad_min "${g}PARAM MIN_SIZE 0\nEND\n"
+expect_text "MAX_CLIQUES MIN_SIZE 0" raw_max_cliques_bad_min "OK\nError: MIN_SIZE must be at least 1\nEND"
+ask raw_max_cliques_directed "ALG MAX_CLIQUES\nDIRECTED 1\nV 3\nE 1\nEDGE 0 1 1\nEND\n"
+expect_text "MAX_CLIQUES on a directed graph" raw_max_cliques_directed "OK\nError: cannot run MAX_CLIQUES on directed graph\nEND"
+
+echo "[30.4] MAX_CLIQUES on a random graph (answer streamed in several pieces, one OK ... END block)"
+printf "ALG MAX_CLIQUES\nRANDOM 1\nDIRECTED 0\nV 400\nE 8000\nSEED 3\nEND\n" \
+  | timeout 10s nc -q 1 -w 5 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_max_cliques_big.out" 2> "$LOG_DIR/raw_max_cliques_big.err" || true
+f="$LOG_DIR/raw_max_cliques_big.out"
+if [ "$(head -n 1 "$f")" != "OK" ] || [ "$(tail -n 1 "$f")" != "END" ] || [ "$(grep -c '^OK$' "$f")" != 1 ] \
+   || [ "$(grep -c '^CLIQUE ' "$f")" != "$(sed -n 's/^RESULT //p' "$f")" ]; then
+  echo "[!] MAX_CLIQUES streamed answer is not one OK ... END block listing RESULT cliques"
+  FAILS=$((FAILS + 1))
+fi
+
 echo "[31] DIRECTED -1 "
 printf "ALG SCC\nDIRECTED -1\nV 3\nE 2\nEDGE 0 1 1\nEDGE 1 2 1\nEND\n" \
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
   > "$LOG_DIR/raw_directed_minus1.out" 2> "$LOG_DIR/raw_directed_minus1.err" || true
 
+if [ "${SKIP_HEAVY:-0}" = "1" ]; then
+  echo "[31.1] Skipped deep SCC path (V=60000) due to SKIP_HEAVY=1"
+else
+  echo "[31.1] SCC on a 60000-vertex directed path closed into one cycle halfway (deep DFS, no recursion)"
+  { printf "ALG SCC\nDIRECTED 1\nV 60000\nE 60000\n"
+    awk 'BEGIN { for (i = 0; i < 59999; i++) print "EDGE " i " " i + 1 " 1"; print "EDGE 59999 30000 1" }'
+    printf "END\n"; } \
+    | timeout 20s nc $NC_CLOSE_OPT -w 10 127.0.0.1 "$PORT" \
+    > "$LOG_DIR/raw_scc_deep_path.out" 2> "$LOG_DIR/raw_scc_deep_path.err" || true
+fi
+
+echo "[31.2] SCC on a random directed graph with 1, 4 and a negative number of threads"
+for thr in 1 4 -1; do
+  printf "ALG SCC\nRANDOM 1\nDIRECTED 1\nV 20000\nE 26000\nSEED 11\nPARAM THREADS $thr\nEND\n" \
+    | timeout 10s nc $NC_CLOSE_OPT -w 5 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_scc_threads.out" 2>> "$LOG_DIR/raw_scc_threads.err" || true
+done
+
+echo "[31.3] SCC_DAG: two 2-cycles joined by an arc, two cycles with parallel joining arcs, an undirected graph, a random graph"
+ask raw_scc_dag_two "ALG SCC_DAG\nDIRECTED 1\nV 4\nE 5\nEDGE 0 1 1\nEDGE 1 0 1\nEDGE 2 3 1\nEDGE 3 2 1\nEDGE 1 2 1\nEND\n"
+expect_text "SCC_DAG on two components" raw_scc_dag_two "OK\nRESULT 2\nARCS 1\nCOMP 1 1 0 0\nOFFSETS 0 0 1\nTARGETS 0\nEND"
+ask raw_scc_dag_parallel "ALG SCC_DAG\nDIRECTED 1\nV 5\nE 7\nEDGE 0 1 1\nEDGE 1 0 1\nEDGE 2 3 1\nEDGE 3 2 1\nEDGE 1 2 1\nEDGE 0 3 1\nEDGE 3 4 1\nEND\n"
+expect_text "SCC_DAG with parallel joining arcs" raw_scc_dag_parallel "OK\nRESULT 3\nARCS 2\nCOMP 2 2 1 1 0\nOFFSETS 0 0 1 2\nTARGETS 0 1\nEND"
+ask raw_scc_dag_undirected "ALG SCC_DAG\nDIRECTED 0\nV 3\nE 2\nEDGE 0 1 1\nEDGE 1 2 1\nEND\n"
+expect_text "SCC_DAG on an undirected graph" raw_scc_dag_undirected "OK\nError: cannot run SCC_DAG on undirected graph\nEND"
+printf "ALG SCC_DAG\nRANDOM 1\nDIRECTED 1\nV 20000\nE 26000\nSEED 11\nEND\n" \
+  | timeout 10s nc -q 1 -w 5 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_scc_dag_big.out" 2> "$LOG_DIR/raw_scc_dag_big.err" || true
+ask raw_scc_dag_big_count "ALG SCC\nRANDOM 1\nDIRECTED 1\nV 20000\nE 26000\nSEED 11\nEND\n"
+if [ "$(tail -n 1 "$LOG_DIR/raw_scc_dag_big.out")" != "END" ] \
+   || [ "$(sed -n 2p "$LOG_DIR/raw_scc_dag_big.out")" != "$(sed -n 2p "$LOG_DIR/raw_scc_dag_big_count.out")" ]; then
+  echo "[!] SCC_DAG on the random graph: not one OK ... END block, or its RESULT differs from SCC's"
+  FAILS=$((FAILS + 1))
+fi
+
+echo "[31.4] SCC sessions: base path, inserted back arc, insert into an unknown session"
+printf "ALG SCC\nDIRECTED 1\nV 4\nE 3\nEDGE 0 1 1\nEDGE 1 2 1\nEDGE 2 3 1\nPARAM SESSION 7\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  >> "$LOG_DIR/raw_scc_session.out" 2>> "$LOG_DIR/raw_scc_session.err" || true
+printf "ALG SCC\nDIRECTED 1\nV 4\nE 1\nEDGE 3 1 1\nPARAM SESSION 7\nPARAM INSERT 1\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  >> "$LOG_DIR/raw_scc_session.out" 2>> "$LOG_DIR/raw_scc_session.err" || true
+printf "ALG SCC\nDIRECTED 1\nV 4\nE 1\nEDGE 3 1 1\nPARAM SESSION 99\nPARAM INSERT 1\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  >> "$LOG_DIR/raw_scc_session.out" 2>> "$LOG_DIR/raw_scc_session.err" || true
+
+echo "[31.5] MST engines: auto, Kruskal and Prim on a heavy-weight graph (total above 2^31), bad MST_ENGINE"
+for eng in 0 1 2 3; do
+  printf "ALG MST\nDIRECTED 0\nV 4\nE 5\nEDGE 0 1 2000000000\nEDGE 1 2 2000000000\nEDGE 2 3 2000000000\nEDGE 0 3 2100000000\nEDGE 0 2 2147483647\nPARAM MST_ENGINE $eng\nEND\n" \
+    | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_mst_engines.out" 2>> "$LOG_DIR/raw_mst_engines.err" || true
+done
+
+echo "[31.6] MST forest: parallel Boruvka on a disconnected graph, engines compared, edge listing, bad THREADS"
+for opt in "PARAM MST_ENGINE 1" "PARAM MST_ENGINE 3" "PARAM THREADS 3" "PARAM THREADS 2\nPARAM LIST 1" "PARAM THREADS -1"; do
+  printf "ALG MST\nDIRECTED 0\nV 7\nE 6\nEDGE 0 1 4\nEDGE 1 2 1\nEDGE 0 2 1\nEDGE 3 4 7\nEDGE 4 5 2\nEDGE 3 5 2\n$opt\nEND\n" \
+    | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+    >> "$LOG_DIR/raw_mst_forest.out" 2>> "$LOG_DIR/raw_mst_forest.err" || true
+done
+
 echo "[32] PREVIEW random with E=0 (count header w/o edges)"
 printf "ALG PREVIEW\nDIRECTED 1\nRANDOM 1\nV 5\nE 0\nEND\n" \
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
@@ -1046,3 +1237,8 @@ fi
 
 
 echo " All test runs completed."
+
+if [ "$FAILS" -ne 0 ]; then
+  echo "[!] $FAILS checked answers were wrong"
+  exit 1
+fi
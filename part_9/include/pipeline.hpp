@@ -27,7 +27,9 @@ enum class AlgKind
 	SINGLE_MAX_FLOW,
 	SINGLE_SCC,
 	SINGLE_MST,
-	SINGLE_CLIQUES
+	SINGLE_CLIQUES,
+	SINGLE_MAX_CLIQUES, // runs in the cliques stage, which streams the answer itself
+	SINGLE_SCC_DAG      // runs in the SCC stage, which streams the answer itself
 };
 
 // A unit of work that flows through the pipeline stages.
@@ -39,6 +41,7 @@ struct Job
 
 	// Request metadata
 	AlgKind kind = AlgKind::ALL; // what to compute, the kind of request
+	std::string max_flow_alg = "MAX_FLOW"; // factory id the max-flow stage runs (MAX_FLOW or MAX_FLOW_PR)
 	bool directed = false;       // if the graph is directed or undirected
 
 	// Inputs for computation